@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <bit>
+#include <chess_engine/attacks/setwise.hpp>
+#include <chess_engine/attacks/sliders.hpp>
+#include <chess_engine/board.hpp>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+/**
+ * Union of the slider attacks of one side, computed per square (one magic or PEXT lookup per piece)
+ * and set-wise (Kogge-Stone fills, independent of the piece count).
+ *
+ * The argument selects the position: reference positions with 2 to 7 sliders per side, then a synthetic
+ * position with seven queens per side, where per-square lookups are at their worst.
+ * Each iteration covers both sides.
+ */
+
+namespace {
+
+constexpr const char* FENS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "qqqqkqqq/8/8/8/8/8/8/QQQQKQQQ w - - 0 1",
+};
+constexpr int POSITION_COUNT = static_cast<int>(std::size(FENS));
+
+struct SliderSets {
+  uint64_t orthogonal;
+  uint64_t diagonal;
+  uint64_t occupied;
+};
+
+std::vector<SliderSets> slider_sets(const char* fen) {
+  const Board board(fen);
+  std::vector<SliderSets> sets;
+  for (Piece::Color color : {Piece::WHITE, Piece::BLACK}) {
+    const uint64_t queens = board.pieces(Piece::make_type(color, Piece::Q)).value();
+    sets.push_back({board.pieces(Piece::make_type(color, Piece::R)).value() | queens,
+                    board.pieces(Piece::make_type(color, Piece::B)).value() | queens, board.occupied().value()});
+  }
+  return sets;
+}
+
+uint64_t per_square_attacks(const SliderSets& sets) {
+  const Bitboard occupied(sets.occupied);
+  uint64_t attacks = 0ULL;
+  for (uint64_t rooks = sets.orthogonal; rooks; rooks &= rooks - 1) {
+    attacks |= Attacks::rook_attacks(Square(std::countr_zero(rooks)), occupied).value();
+  }
+  for (uint64_t bishops = sets.diagonal; bishops; bishops &= bishops - 1) {
+    attacks |= Attacks::bishop_attacks(Square(std::countr_zero(bishops)), occupied).value();
+  }
+  return attacks;
+}
+
+uint64_t setwise_attacks(const SliderSets& sets) {
+  const Bitboard empty(~sets.occupied);
+  return (Attacks::rook_attacks_setwise(sets.orthogonal, empty) | Attacks::bishop_attacks_setwise(sets.diagonal, empty))
+      .value();
+}
+
+}  // namespace
+
+static void BM_SliderAttacksPerSquare(benchmark::State& state) {
+  const std::vector<SliderSets> positions = slider_sets(FENS[state.range(0)]);
+  for (auto _ : state) {
+    for (const SliderSets& sets : positions) benchmark::DoNotOptimize(per_square_attacks(sets));
+  }
+  state.SetLabel(FENS[state.range(0)]);
+}
+BENCHMARK(BM_SliderAttacksPerSquare)->DenseRange(0, POSITION_COUNT - 1);
+
+static void BM_SliderAttacksSetwise(benchmark::State& state) {
+  const std::vector<SliderSets> positions = slider_sets(FENS[state.range(0)]);
+  for (auto _ : state) {
+    for (const SliderSets& sets : positions) benchmark::DoNotOptimize(setwise_attacks(sets));
+  }
+  state.SetLabel(FENS[state.range(0)]);
+}
+BENCHMARK(BM_SliderAttacksSetwise)->DenseRange(0, POSITION_COUNT - 1);
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <chess_engine/bitboard.hpp>
+#include <chess_engine/square.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Iteration over the set squares of a bitboard: testing all 64 squares (as Bitboard::print does)
+ * against the range-for iterator, which is a bit scan plus a clear-lowest-bit per set square.
+ *
+ * With BMI1 enabled (e.g. -march=haswell) the iterator loop body compiles to TZCNT + BLSR;
+ * with baseline x86-64 flags it is REP BSF (executed as TZCNT where supported) + a LEA/AND pair.
+ */
+
+namespace {
+
+std::vector<uint64_t> make_bitboards(int density_shift) {
+  std::vector<uint64_t> bitboards(1024);
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (uint64_t& bb : bitboards) {
+    bb = ~0ULL;
+    for (int i = 0; i < density_shift; ++i) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      bb &= state;
+    }
+  }
+  return bitboards;
+}
+
+}  // namespace
+
+static void BM_IterateTestAllSquares(benchmark::State& state) {
+  const std::vector<uint64_t> bitboards = make_bitboards(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    int sum = 0;
+    for (const uint64_t raw : bitboards) {
+      const Bitboard bb(raw);
+      for (int sq = 0; sq < 64; ++sq) {
+        if (bb.test(static_cast<Square::Value>(sq))) sum += sq;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bitboards.size()));
+}
+BENCHMARK(BM_IterateTestAllSquares)->DenseRange(1, 4);
+
+static void BM_IterateRangeFor(benchmark::State& state) {
+  const std::vector<uint64_t> bitboards = make_bitboards(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    int sum = 0;
+    for (const uint64_t raw : bitboards) {
+      for (Square sq : Bitboard(raw)) sum += sq.value();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bitboards.size()));
+}
+BENCHMARK(BM_IterateRangeFor)->DenseRange(1, 4);
+
+static void BM_IteratePopLsb(benchmark::State& state) {
+  const std::vector<uint64_t> bitboards = make_bitboards(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    int sum = 0;
+    for (const uint64_t raw : bitboards) {
+      for (Bitboard bb(raw); !bb.empty();) sum += bb.pop_lsb().value();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bitboards.size()));
+}
+BENCHMARK(BM_IteratePopLsb)->DenseRange(1, 4);
+
+static void BM_Popcount(benchmark::State& state) {
+  const std::vector<uint64_t> bitboards = make_bitboards(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    int sum = 0;
+    for (const uint64_t raw : bitboards) sum += Bitboard(raw).popcount();
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bitboards.size()));
+}
+BENCHMARK(BM_Popcount)->DenseRange(1, 4);
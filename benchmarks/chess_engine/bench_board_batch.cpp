@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <chess_engine/board.hpp>
+#include <chess_engine/board_batch.hpp>
+#include <chess_engine/movegen.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Throughput of the BoardBatch kernels per backend, on 4096 positions from random legal games.
+ * The argument selects the backend (0 = scalar, 1 = AVX2); unsupported backends are skipped.
+ */
+
+namespace {
+
+constexpr std::size_t BATCH_SIZE = 4096;
+
+BoardBatch make_batch() {
+  BoardBatch batch;
+  batch.reserve(BATCH_SIZE);
+  uint64_t state = 0x2545F4914F6CDD1DULL;
+  while (batch.size() < BATCH_SIZE) {
+    Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    for (int ply = 0; ply < 80 && batch.size() < BATCH_SIZE; ++ply) {
+      batch.push_back(board);
+      MoveList moves;
+      MoveGen::generate_legal(board, moves);
+      if (moves.empty()) break;
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      board.make_move(moves[state % moves.size()]);
+    }
+  }
+  return batch;
+}
+
+// Built on first use: the slider tables used by the move generator are set up by another translation unit
+const BoardBatch& batch() {
+  static const BoardBatch positions = make_batch();
+  return positions;
+}
+
+template <typename Kernel>
+void run_kernel(benchmark::State& state, Kernel kernel) {
+  const auto backend = static_cast<BatchKernels::Backend>(state.range(0));
+  const BatchKernels::Backend startup_backend = BatchKernels::backend();
+  if (!BatchKernels::select_backend(backend)) {
+    state.SkipWithError("backend not supported on this CPU");
+    return;
+  }
+  std::vector<uint64_t> out(batch().size());
+  for (auto _ : state) {
+    kernel(out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch().size()));
+  state.SetLabel(BatchKernels::backend_name(backend));
+  BatchKernels::select_backend(startup_backend);
+}
+
+}  // namespace
+
+static void BM_BatchOccupancy(benchmark::State& state) {
+  run_kernel(state, [](std::vector<uint64_t>& out) { BatchKernels::occupancy(batch(), out); });
+}
+BENCHMARK(BM_BatchOccupancy)->Arg(0)->Arg(1);
+
+static void BM_BatchPawnAttacks(benchmark::State& state) {
+  run_kernel(state, [](std::vector<uint64_t>& out) { BatchKernels::pawn_attacks(batch(), Piece::WHITE, out); });
+}
+BENCHMARK(BM_BatchPawnAttacks)->Arg(0)->Arg(1);
+
+static void BM_BatchRookAttacks(benchmark::State& state) {
+  run_kernel(state, [](std::vector<uint64_t>& out) { BatchKernels::rook_attacks(batch(), Piece::WHITE, out); });
+}
+BENCHMARK(BM_BatchRookAttacks)->Arg(0)->Arg(1);
+
+static void BM_BatchBishopAttacks(benchmark::State& state) {
+  run_kernel(state, [](std::vector<uint64_t>& out) { BatchKernels::bishop_attacks(batch(), Piece::WHITE, out); });
+}
+BENCHMARK(BM_BatchBishopAttacks)->Arg(0)->Arg(1);
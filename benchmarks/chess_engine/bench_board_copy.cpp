@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <chess_engine/board.hpp>
+#include <chess_engine/movegen.hpp>
+#include <cstdint>
+#include <string>
+
+/**
+ * Copy-make against make/unmake, on a legal perft tree walk (no bulk counting, so every leaf plays a move).
+ *
+ * Copy-make copies the whole Board per ply (sizeof(Board) is reported as a counter) and throws the child away;
+ * make/unmake updates one board in place and restores it from the UndoInfo record. Which one wins depends on the
+ * memory bandwidth of the platform against the cost of the unmake branches, hence both are measured.
+ */
+
+namespace {
+
+const std::string START = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+const std::string KIWIPETE = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+uint64_t walk_copy_make(const Board& board, int depth) {
+  if (depth == 0) return 1;
+  MoveList moves;
+  MoveGen::generate_legal(board, moves);
+  uint64_t nodes = 0;
+  for (const Move move : moves) {
+    Board child = board;
+    child.make_move(move);
+    nodes += walk_copy_make(child, depth - 1);
+  }
+  return nodes;
+}
+
+uint64_t walk_make_unmake(Board& board, int depth) {
+  if (depth == 0) return 1;
+  MoveList moves;
+  MoveGen::generate_legal(board, moves);
+  uint64_t nodes = 0;
+  for (const Move move : moves) {
+    const Board::UndoInfo undo = board.make_move(move);
+    nodes += walk_make_unmake(board, depth - 1);
+    board.unmake_move(move, undo);
+  }
+  return nodes;
+}
+
+}  // namespace
+
+static void BM_CopyMake(benchmark::State& state, const std::string& fen, int depth) {
+  const Board board(fen);
+  uint64_t nodes = 0;
+  for (auto _ : state) {
+    nodes = walk_copy_make(board, depth);
+    benchmark::DoNotOptimize(nodes);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(nodes));
+  state.counters["sizeof_board"] = sizeof(Board);
+}
+BENCHMARK_CAPTURE(BM_CopyMake, start, START, 4);
+BENCHMARK_CAPTURE(BM_CopyMake, kiwipete, KIWIPETE, 3);
+
+static void BM_MakeUnmake(benchmark::State& state, const std::string& fen, int depth) {
+  Board board(fen);
+  uint64_t nodes = 0;
+  for (auto _ : state) {
+    nodes = walk_make_unmake(board, depth);
+    benchmark::DoNotOptimize(nodes);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(nodes));
+  state.counters["sizeof_board"] = sizeof(Board);
+}
+BENCHMARK_CAPTURE(BM_MakeUnmake, start, START, 4);
+BENCHMARK_CAPTURE(BM_MakeUnmake, kiwipete, KIWIPETE, 3);
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <chess_engine/board.hpp>
+#include <string>
+#include <string_view>
+
+/**
+ * FEN throughput in positions per second: Board::from_fen parses a string_view without allocating, the string
+ * constructor wraps it (and needs a std::string), to_fen writes into a caller buffer or returns a std::string.
+ */
+
+namespace {
+
+constexpr std::array<std::string_view, 6> FENS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+};
+
+}  // namespace
+
+static void BM_FromFen(benchmark::State& state) {
+  for (auto _ : state) {
+    for (const std::string_view fen : FENS) {
+      auto board = Board::from_fen(fen);
+      benchmark::DoNotOptimize(board);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(FENS.size()));
+}
+BENCHMARK(BM_FromFen);
+
+static void BM_StringConstructor(benchmark::State& state) {
+  for (auto _ : state) {
+    for (const std::string_view fen : FENS) {
+      Board board{std::string(fen)};
+      benchmark::DoNotOptimize(board);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(FENS.size()));
+}
+BENCHMARK(BM_StringConstructor);
+
+static void BM_ToFenBuffer(benchmark::State& state) {
+  std::array<Board, FENS.size()> boards;
+  for (std::size_t i = 0; i < FENS.size(); ++i) boards[i] = *Board::from_fen(FENS[i]);
+  char buffer[Board::MAX_FEN_LENGTH];
+  for (auto _ : state) {
+    for (const Board& board : boards) {
+      benchmark::DoNotOptimize(board.to_fen(buffer));
+      benchmark::ClobberMemory();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(boards.size()));
+}
+BENCHMARK(BM_ToFenBuffer);
+
+static void BM_ToFenString(benchmark::State& state) {
+  std::array<Board, FENS.size()> boards;
+  for (std::size_t i = 0; i < FENS.size(); ++i) boards[i] = *Board::from_fen(FENS[i]);
+  for (auto _ : state) {
+    for (const Board& board : boards) benchmark::DoNotOptimize(board.to_fen());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(boards.size()));
+}
+BENCHMARK(BM_ToFenString);
@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <chess_engine/attacks/bishop.hpp>
+#include <chess_engine/attacks/rook.hpp>
+#include <chess_engine/bitboard.hpp>
+#include <cstdint>
+
+/**
+ * Square-pair tables for pins, check evasions and static exchange evaluation.
+ *
+ * Both tables are indexed by two squares and hold 64 x 64 bitboards, i.e. 32 KiB each and 64 KiB together:
+ * more than a typical 32-48 KiB L1 data cache but well within L2 (256 KiB and up), and move generation only
+ * touches the rows of the two kings. They are built at compile time from the single-direction ray helpers of
+ * rook.hpp and bishop.hpp, and declared inline so that the program holds a single copy.
+ */
+namespace Attacks {
+
+namespace detail {
+
+using RayFunction = uint64_t (*)(int);
+
+/**
+ * @brief The four lines through a square, each as a pair of opposite ray directions.
+ */
+constexpr std::array<std::array<RayFunction, 2>, 4> LINE_RAYS = {{
+    {rook_north_attacks, rook_south_attacks},
+    {rook_east_attacks, rook_west_attacks},
+    {bishop_northeast_attacks, bishop_southwest_attacks},
+    {bishop_northwest_attacks, bishop_southeast_attacks},
+}};
+
+}  // namespace detail
+
+/**
+ * @brief Squares strictly between two squares, indexed [a][b].
+ *
+ * Empty if a and b do not share a rank, a file or a diagonal, or if they are adjacent.
+ * Symmetric: BETWEEN[a][b] == BETWEEN[b][a].
+ */
+inline constexpr std::array<std::array<Bitboard, 64>, 64> BETWEEN = []() constexpr {
+  std::array<std::array<Bitboard, 64>, 64> table{};
+  for (int a = 0; a < 64; ++a) {
+    for (const auto& line : detail::LINE_RAYS) {
+      for (const detail::RayFunction ray : line) {
+        // Walking from a, the squares before b are the ray from a minus b and the ray beyond b
+        for (uint64_t targets = ray(a); targets; targets &= targets - 1) {
+          const int b = std::countr_zero(targets);
+          table[a][b] = Bitboard(ray(a) & ~ray(b) & ~(1ULL << b));
+        }
+      }
+    }
+  }
+  return table;
+}();
+
+/**
+ * @brief Full line through two squares, edge to edge and both squares included, indexed [a][b].
+ *
+ * Empty if a and b do not share a rank, a file or a diagonal (including a == b).
+ * Symmetric: LINE[a][b] == LINE[b][a].
+ */
+inline constexpr std::array<std::array<Bitboard, 64>, 64> LINE = []() constexpr {
+  std::array<std::array<Bitboard, 64>, 64> table{};
+  for (int a = 0; a < 64; ++a) {
+    for (const auto& [forward, backward] : detail::LINE_RAYS) {
+      const uint64_t others = forward(a) | backward(a);
+      for (uint64_t targets = others; targets; targets &= targets - 1) {
+        table[a][std::countr_zero(targets)] = Bitboard(others | (1ULL << a));
+      }
+    }
+  }
+  return table;
+}();
+
+}  // namespace Attacks
@@ -0,0 +1,152 @@
+#pragma once
+#include <array>
+#include <chess_engine/attacks/bishop.hpp>
+#include <chess_engine/attacks/rook.hpp>
+#include <chess_engine/bitboard.hpp>
+#include <chess_engine/bitmasks.hpp>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Occupancy-aware sliding piece attacks using fixed-shift magic bitboards.
+ *
+ * For a slider on a given square, only the blockers on its rays matter, and among those only the ones that are
+ * not on the board edge (a piece on the edge square does not hide anything behind it). These squares form the
+ * relevance mask of the square.
+ *
+ * The relevant blockers are hashed into a dense table index with a multiply and a shift:
+ *
+ *   index = ((occupancy & mask) * magic) >> (64 - INDEX_BITS)
+ *
+ * The magic numbers below were chosen so that two blocker sets mapping to the same index always produce the same
+ * attack set. The shift is the same for every square (12 bits for rooks, 9 bits for bishops), which wastes some
+ * table space on squares with fewer relevant bits but keeps the lookup branch-free and the tables trivial to lay out:
+ * - Rooks: 64 * 4096 entries (2 MiB)
+ * - Bishops: 64 * 512 entries (256 KiB)
+ *
+ * The lookup functions themselves live in sliders.hpp, which can also index the same tables with PEXT.
+ *
+ * @see https://www.chessprogramming.org/Magic_Bitboards
+ */
+namespace Attacks {
+
+/**
+ * @brief Computes the relevance mask of a rook on the given square.
+ * @param sq The square index (0-63).
+ * @return Rook rays from `sq`, without the last square of each ray (board edge).
+ */
+constexpr uint64_t rook_relevant_occupancy(int sq) {
+  using namespace Bitmasks;
+  return (rook_north_attacks(sq) & ~RANK_8) | (rook_south_attacks(sq) & ~RANK_1) | (rook_east_attacks(sq) & ~FILE_H) |
+         (rook_west_attacks(sq) & ~FILE_A);
+}
+
+/**
+ * @brief Computes the relevance mask of a bishop on the given square.
+ * @param sq The square index (0-63).
+ * @return Bishop rays from `sq`, without the board edges.
+ */
+constexpr uint64_t bishop_relevant_occupancy(int sq) {
+  using namespace Bitmasks;
+  return bishop_attacks_for_square(sq) & ~(FILE_A | FILE_H | RANK_1 | RANK_8);
+}
+
+/**
+ * @brief Number of index bits used by the rook magic tables (same for every square).
+ */
+constexpr int ROOK_INDEX_BITS = 12;
+
+/**
+ * @brief Number of index bits used by the bishop magic tables (same for every square).
+ */
+constexpr int BISHOP_INDEX_BITS = 9;
+
+/**
+ * @brief Precomputed rook relevance masks, indexed by square (0-63).
+ */
+constexpr std::array<Bitboard, 64> ROOK_MASKS = []() constexpr {
+  std::array<Bitboard, 64> table{};
+  for (int sq = 0; sq < 64; ++sq) {
+    table[sq] = Bitboard(rook_relevant_occupancy(sq));
+  }
+  return table;
+}();
+
+/**
+ * @brief Precomputed bishop relevance masks, indexed by square (0-63).
+ */
+constexpr std::array<Bitboard, 64> BISHOP_MASKS = []() constexpr {
+  std::array<Bitboard, 64> table{};
+  for (int sq = 0; sq < 64; ++sq) {
+    table[sq] = Bitboard(bishop_relevant_occupancy(sq));
+  }
+  return table;
+}();
+
+/**
+ * @brief Rook magic multipliers for a fixed shift of 64 - ROOK_INDEX_BITS, indexed by square (0-63).
+ */
+constexpr std::array<uint64_t, 64> ROOK_MAGICS = {
+    0x1080004008801020ULL, 0x0840092002C03000ULL, 0x0408080040206400ULL, 0x1200020044042009ULL,
+    0x0200042008100200ULL, 0x0480088004002600ULL, 0x20801100D8080882ULL, 0x030004420A218100ULL,
+    0x12A0800040008020ULL, 0x8208404000200010ULL, 0x0200500020040130ULL, 0x1108200810224C80ULL,
+    0x9030008841000810ULL, 0x0422800214028008ULL, 0x0840300100004081ULL, 0x4220081200C20023ULL,
+    0x4080000821104000ULL, 0x0121A10408824002ULL, 0x0001060010205600ULL, 0x0010600204091040ULL,
+    0x0100220016000402ULL, 0x0800408004020041ULL, 0x00051004B2100810ULL, 0x00122840008015A1ULL,
+    0x2800C80090001002ULL, 0x0A48916020003814ULL, 0x1404388239040004ULL, 0x04A0500200060010ULL,
+    0x8000100118000840ULL, 0x001C00240048D002ULL, 0x0042000080420100ULL, 0x0000010028009046ULL,
+    0x2140401298080040ULL, 0x08000C20C0400241ULL, 0x008220810010C940ULL, 0x28100012001C1808ULL,
+    0x0400880004034016ULL, 0x0940042801440008ULL, 0x0000006116043100ULL, 0x5000048005006002ULL,
+    0x1281412110200800ULL, 0x0008830024010042ULL, 0x2000042400801200ULL, 0x8220400402442080ULL,
+    0x2200022001401400ULL, 0x0002001580081010ULL, 0x00405102804004E2ULL, 0x0430004C10220001ULL,
+    0x0100100800A30210ULL, 0x4000200140025410ULL, 0x1021000884410008ULL, 0x04000800043A2008ULL,
+    0x0128000900840050ULL, 0x0000104008020088ULL, 0x4400010002028288ULL, 0x80020080013A0040ULL,
+    0x000A20C100108001ULL, 0x2000202900409112ULL, 0x0420000502441209ULL, 0x0002081200204002ULL,
+    0x1000100A22001582ULL, 0x8001815001820006ULL, 0x98801290500800A4ULL, 0x6090040021004882ULL
+};
+
+/**
+ * @brief Bishop magic multipliers for a fixed shift of 64 - BISHOP_INDEX_BITS, indexed by square (0-63).
+ */
+constexpr std::array<uint64_t, 64> BISHOP_MAGICS = {
+    0x0C11011208004003ULL, 0x0810150E1804C020ULL, 0x008C0014000C0100ULL, 0x10020A0104101110ULL,
+    0x004E04A203040020ULL, 0x04048921A0860600ULL, 0x2440101500214C54ULL, 0x000C030410240200ULL,
+    0x0080028042009680ULL, 0x008220044042800CULL, 0x8000212204005104ULL, 0x0810222020202080ULL,
+    0x0020208228023808ULL, 0x8208122402044000ULL, 0x0004002012101000ULL, 0x000140132500804CULL,
+    0x0684142000708012ULL, 0x0024808021001020ULL, 0x000424004102020CULL, 0x0604801028820000ULL,
+    0x2022000420040040ULL, 0x0400400080504000ULL, 0x4014480032001000ULL, 0x0020240017010011ULL,
+    0x000A202008200041ULL, 0x4018020000202065ULL, 0x0008224800910044ULL, 0x0140040006020908ULL,
+    0x80A002002B010880ULL, 0x4004048203008080ULL, 0x0148001CA2004102ULL, 0x000090900034C108ULL,
+    0x00008048E40C0020ULL, 0x0000820108200C20ULL, 0x0242010A01090A01ULL, 0x4102220280080080ULL,
+    0x0944040400031010ULL, 0x1021020480800808ULL, 0x8402206520408040ULL, 0x00080021C000080AULL,
+    0x200011507808A021ULL, 0x0802805006001480ULL, 0x1001002080400480ULL, 0x0002002008000020ULL,
+    0x003016020C000032ULL, 0x8008300086810208ULL, 0x0010100160400884ULL, 0x0003141080441A08ULL,
+    0x1240128800450250ULL, 0x4640818290008104ULL, 0x8421008E0A548004ULL, 0x0060232042002006ULL,
+    0x1020020310048000ULL, 0x0001080208004C00ULL, 0x0010029090104058ULL, 0x0080C20421420021ULL,
+    0x5000110048200102ULL, 0x006A004008201106ULL, 0x0090860806080C70ULL, 0x818000100C060200ULL,
+    0x50000000008A1204ULL, 0x5000001020880041ULL, 0x8120101148804180ULL, 0x0820040400440021ULL
+};
+
+/**
+ * @brief Size of the rook attack table (one block of 2^ROOK_INDEX_BITS entries per square).
+ */
+constexpr std::size_t ROOK_TABLE_SIZE = std::size_t{64} << ROOK_INDEX_BITS;
+
+/**
+ * @brief Size of the bishop attack table (one block of 2^BISHOP_INDEX_BITS entries per square).
+ */
+constexpr std::size_t BISHOP_TABLE_SIZE = std::size_t{64} << BISHOP_INDEX_BITS;
+
+/**
+ * @brief Computes the magic index of an occupancy inside the block of a square.
+ * @param occupancy Occupancy of the whole board.
+ * @param mask Relevance mask of the square.
+ * @param magic Magic multiplier of the square.
+ * @param bits Number of index bits.
+ * @return Index in range [0, 2^bits).
+ */
+constexpr uint64_t magic_index(uint64_t occupancy, uint64_t mask, uint64_t magic, int bits) {
+  return ((occupancy & mask) * magic) >> (64 - bits);
+}
+
+}  // namespace Attacks
@@ -93,9 +93,9 @@ constexpr std::array<Bitboard, 64> WHITE_PAWN_ATTACKS = []() constexpr {
   for (int sq = 0; sq < 64; ++sq) {
     uint64_t bb = 1ULL << sq;
     uint64_t attacks = 0;
-    if (sq / 8 < 7) {        // rank 1..7
-      attacks |= (bb << 7);  // NW
-      attacks |= (bb << 9);  // NE
+    if (sq / 8 < 7) {                  // rank 1..7
+      attacks |= (bb << 7) & ~FILE_H;  // NW, no wrap from file A
+      attacks |= (bb << 9) & ~FILE_A;  // NE, no wrap from file H
     }
     table[sq] = Bitboard(attacks);
   }
@@ -117,9 +117,9 @@ constexpr std::array<Bitboard, 64> BLACK_PAWN_ATTACKS = []() constexpr {
   for (int sq = 0; sq < 64; ++sq) {
     uint64_t bb = 1ULL << sq;
     uint64_t attacks = 0;
-    if (sq / 8 > 0) {        // rank 2..8
-      attacks |= (bb >> 9);  // SW
-      attacks |= (bb >> 7);  // SE
+    if (sq / 8 > 0) {                  // rank 2..8
+      attacks |= (bb >> 9) & ~FILE_H;  // SW, no wrap from file A
+      attacks |= (bb >> 7) & ~FILE_A;  // SE, no wrap from file H
     }
     table[sq] = Bitboard(attacks);
   }
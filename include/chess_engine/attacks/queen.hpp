@@ -2,6 +2,7 @@
 #include <array>
 #include <chess_engine/attacks/bishop.hpp>
 #include <chess_engine/attacks/rook.hpp>
+#include <chess_engine/attacks/sliders.hpp>
 #include <chess_engine/bitboard.hpp>
 #include <chess_engine/bitmasks.hpp>
 #include <cstdint>
@@ -33,4 +34,14 @@ constexpr std::array<Bitboard, 64> QUEEN_ATTACKS = []() constexpr {
   return table;
 }();
 
+/**
+ * @brief Returns the squares attacked by a queen, stopping at the first blocker on each ray.
+ * @param sq Square of the queen.
+ * @param occupancy All occupied squares (both colors). Blockers are included in the result.
+ * @return Bitboard of attacked squares.
+ */
+inline Bitboard queen_attacks(Square sq, Bitboard occupancy) {
+  return rook_attacks(sq, occupancy) | bishop_attacks(sq, occupancy);
+}
+
 }  // namespace Attacks
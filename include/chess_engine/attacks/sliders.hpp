@@ -0,0 +1,126 @@
+#pragma once
+#include <array>
+#include <chess_engine/attacks/magic.hpp>
+#include <chess_engine/attacks/pext.hpp>
+#include <chess_engine/bitboard.hpp>
+#include <chess_engine/square.hpp>
+#include <cstdint>
+
+/**
+ * Occupancy-aware sliding piece attacks.
+ *
+ * Two interchangeable backends index the attack tables:
+ * - SliderBackend::Magic: fixed-shift multiply-shift magics (magic.hpp), portable
+ * - SliderBackend::Pext: BMI2 PEXT (pext.hpp), denser tables, faster on CPUs with a hardware PEXT
+ *
+ * The backend is picked when the tables are first used: PEXT when Cpu::has_fast_pext() is true, magics otherwise.
+ * Both share the same per-square entries and table storage; only the index computation and the table layout differ.
+ */
+namespace Attacks {
+
+/**
+ * @brief Slider attack table indexing strategies.
+ */
+enum class SliderBackend { Magic, Pext };
+
+/**
+ * @brief Lookup data of one square for one slider type.
+ */
+struct SliderEntry {
+  uint64_t mask;             ///< Relevance mask of the square
+  uint64_t magic;            ///< Magic multiplier (unused by the PEXT backend)
+  const Bitboard* attacks;   ///< First entry of the square's block in the attack table
+};
+
+namespace detail {
+
+/**
+ * @brief Lookup data and attack tables of both slider types for the active backend.
+ */
+struct SliderTables {
+  SliderBackend backend;
+  std::array<SliderEntry, 64> rook;
+  std::array<SliderEntry, 64> bishop;
+
+  // Shared storage, large enough for either layout (the magic layout is the larger one).
+  std::array<Bitboard, ROOK_TABLE_SIZE> rook_attacks;
+  std::array<Bitboard, BISHOP_TABLE_SIZE> bishop_attacks;
+
+  /** Builds the tables for the fastest backend of the CPU: PEXT when Cpu::has_fast_pext() is true. */
+  SliderTables();
+
+  /** Rebuilds the tables for another backend. */
+  void build(SliderBackend selected);
+};
+
+/**
+ * @brief Returns the slider tables, built on first use.
+ *
+ * A function-local static rather than a namespace-scope one: attacks looked up from the static initializer of
+ * another translation unit still find the tables built. After the first call, the guard is a predicted branch.
+ */
+inline SliderTables& slider_tables() {
+  static SliderTables tables;
+  return tables;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Returns the backend currently used by rook_attacks() and bishop_attacks().
+ */
+inline SliderBackend slider_backend() { return detail::slider_tables().backend; }
+
+/**
+ * @brief Returns a printable name for a backend ("magic" or "pext").
+ */
+const char* slider_backend_name(SliderBackend backend);
+
+/**
+ * @brief Checks if a backend can run on this build and CPU.
+ */
+bool slider_backend_supported(SliderBackend backend);
+
+/**
+ * @brief Switches to another backend and rebuilds the attack tables.
+ * @param backend Backend to activate.
+ * @return false (and keeps the current backend) if `backend` is not supported.
+ *
+ * Meant for tests and benchmarks. Not thread-safe: no other thread may be looking up attacks meanwhile.
+ */
+bool select_slider_backend(SliderBackend backend);
+
+/**
+ * @brief Computes the index of an occupancy inside the block of a square.
+ */
+inline uint64_t slider_index(SliderBackend backend, const SliderEntry& entry, uint64_t occupancy, int bits) {
+  // Always the same outcome for a given run: the branch is perfectly predicted.
+  if (backend == SliderBackend::Pext) return pext(occupancy, entry.mask);
+  return magic_index(occupancy, entry.mask, entry.magic, bits);
+}
+
+/**
+ * @brief Returns the squares attacked by a rook, stopping at the first blocker on each ray.
+ * @param sq Square of the rook.
+ * @param occupancy All occupied squares (both colors). Blockers are included in the result.
+ * @return Bitboard of attacked squares.
+ */
+inline Bitboard rook_attacks(Square sq, Bitboard occupancy) {
+  const detail::SliderTables& tables = detail::slider_tables();
+  const SliderEntry& entry = tables.rook[sq.value()];
+  return entry.attacks[slider_index(tables.backend, entry, occupancy.value(), ROOK_INDEX_BITS)];
+}
+
+/**
+ * @brief Returns the squares attacked by a bishop, stopping at the first blocker on each ray.
+ * @param sq Square of the bishop.
+ * @param occupancy All occupied squares (both colors). Blockers are included in the result.
+ * @return Bitboard of attacked squares.
+ */
+inline Bitboard bishop_attacks(Square sq, Bitboard occupancy) {
+  const detail::SliderTables& tables = detail::slider_tables();
+  const SliderEntry& entry = tables.bishop[sq.value()];
+  return entry.attacks[slider_index(tables.backend, entry, occupancy.value(), BISHOP_INDEX_BITS)];
+}
+
+}  // namespace Attacks
@@ -1,8 +1,26 @@
 #pragma once
+#include <bit>
+#include <chess_engine/bitmasks.hpp>
 #include <chess_engine/square.hpp>
 #include <cstdint>
 #include <iostream>
 
+/**
+ * @brief Compass directions, valued as the bit offset of one step on a Bitboard.
+ *
+ * Kept unscoped so that a direction can be used directly as a shift amount or a square offset.
+ */
+enum Direction : int {
+  NORTH = 8,
+  SOUTH = -8,
+  EAST = 1,
+  WEST = -1,
+  NORTH_EAST = 9,
+  NORTH_WEST = 7,
+  SOUTH_EAST = -7,
+  SOUTH_WEST = -9,
+};
+
 /**
  * @class Bitboard
  * @brief Wrapper around a 64-bit unsigned integer to represent a bitboard.
@@ -44,7 +62,7 @@ class Bitboard {
   constexpr Bitboard(uint64_t value) : m_bb(value) {}
 
   /** @brief Returns the raw 64-bit value of the bitboard. */
-  constexpr uint64_t value() { return m_bb; }
+  constexpr uint64_t value() const { return m_bb; }
 
   /**
    * @brief Sets a bit (places a piece) on a given square.
@@ -106,6 +124,81 @@ class Bitboard {
   /** @brief Clears the whole bitboard (all bits = 0). */
   constexpr void reset() { m_bb = 0ULL; }
 
+  /** @brief Checks if no square is set. */
+  constexpr bool empty() const { return m_bb == 0ULL; }
+
+  /** @brief Returns the number of set squares (POPCNT when available). */
+  constexpr int popcount() const { return std::popcount(m_bb); }
+
+  /** @brief Checks if more than one square is set, without counting them. */
+  constexpr bool more_than_one() const { return (m_bb & (m_bb - 1)) != 0ULL; }
+
+  /**
+   * @brief Returns the set square with the lowest index (TZCNT/BSF when available).
+   * @pre The bitboard is not empty.
+   */
+  constexpr Square lsb() const { return Square::unchecked(std::countr_zero(m_bb)); }
+
+  /**
+   * @brief Returns the set square with the lowest index and clears it.
+   * @pre The bitboard is not empty.
+   *
+   * `m_bb & (m_bb - 1)` clears the lowest set bit (a single BLSR with BMI1).
+   */
+  constexpr Square pop_lsb() {
+    const Square sq = lsb();
+    m_bb &= m_bb - 1;
+    return sq;
+  }
+
+  /**
+   * @brief Shifts every square one step in a direction, dropping the squares leaving the board.
+   * @tparam D Direction of the step.
+   *
+   * North and south steps fall off the top or the bottom of the 64 bits on their own. Steps with an east
+   * (resp. west) component would wrap from file H to file A (resp. A to H) of the next rank, so the
+   * destinations on file A (resp. H) are masked out.
+   */
+  template <Direction D>
+  constexpr Bitboard shift() const {
+    using namespace Bitmasks;
+    if constexpr (D == NORTH) return m_bb << 8;
+    if constexpr (D == SOUTH) return m_bb >> 8;
+    if constexpr (D == EAST) return (m_bb << 1) & ~FILE_A;
+    if constexpr (D == WEST) return (m_bb >> 1) & ~FILE_H;
+    if constexpr (D == NORTH_EAST) return (m_bb << 9) & ~FILE_A;
+    if constexpr (D == NORTH_WEST) return (m_bb << 7) & ~FILE_H;
+    if constexpr (D == SOUTH_EAST) return (m_bb >> 7) & ~FILE_A;
+    if constexpr (D == SOUTH_WEST) return (m_bb >> 9) & ~FILE_H;
+  }
+
+  /**
+   * @brief Forward iterator over the set squares, from the lowest index to the highest.
+   *
+   * The iterator is the remaining bits themselves: dereferencing is a bit scan and incrementing clears the
+   * lowest bit, so `for (Square sq : bb)` costs the same as a hand-written pop_lsb loop.
+   */
+  class Iterator {
+   private:
+    uint64_t m_remaining;
+
+   public:
+    constexpr explicit Iterator(uint64_t remaining) : m_remaining(remaining) {}
+    constexpr Square operator*() const { return Square::unchecked(std::countr_zero(m_remaining)); }
+    constexpr Iterator& operator++() {
+      m_remaining &= m_remaining - 1;
+      return *this;
+    }
+    constexpr bool operator==(const Iterator& other) const { return m_remaining == other.m_remaining; }
+    constexpr bool operator!=(const Iterator& other) const { return m_remaining != other.m_remaining; }
+  };
+
+  /** @brief Iterator on the lowest set square. */
+  constexpr Iterator begin() const { return Iterator(m_bb); }
+
+  /** @brief Iterator past the last set square (no square left). */
+  constexpr Iterator end() const { return Iterator(0ULL); }
+
   /**
    * @brief Prints the bitboard as an 8×8 grid.
    *
@@ -128,6 +221,7 @@ class Bitboard {
   constexpr bool operator!=(const Bitboard& other) const { return m_bb != other.m_bb; }
   constexpr Bitboard operator|(const Bitboard& other) const { return m_bb | other.m_bb; }
   constexpr Bitboard operator&(const Bitboard& other) const { return m_bb & other.m_bb; }
+  constexpr Bitboard operator^(const Bitboard& other) const { return m_bb ^ other.m_bb; }
   constexpr Bitboard operator~() const { return ~m_bb; }
   constexpr Bitboard operator<<(int n) const { return m_bb << n; }
   constexpr Bitboard operator>>(int n) const { return m_bb >> n; }
@@ -139,4 +233,8 @@ class Bitboard {
     m_bb &= other.m_bb;
     return *this;
   }
+  constexpr Bitboard& operator^=(const Bitboard& other) {
+    m_bb ^= other.m_bb;
+    return *this;
+  }
 };
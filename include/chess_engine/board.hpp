@@ -1,8 +1,17 @@
 #pragma once
+#include <array>
 #include <chess_engine/bitboard.hpp>
+#include <chess_engine/fen.hpp>
+#include <chess_engine/move.hpp>
 #include <chess_engine/piece.hpp>
 #include <chess_engine/square.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
 #include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 
 /**
  * @class Board
@@ -12,37 +21,119 @@
  * - White: pawns, rooks, bishops, knights, king, queen
  * - Black: pawns, rooks, bishops, knights, king, queen
  *
- * Additional game state is tracked:
+ * A 64-entry mailbox mirrors the bitboards and stores the piece type found on each square,
+ * so that square lookups, captures and removals only touch one byte and one bitboard.
+ *
+ * The per-color and total occupancies are maintained incrementally alongside the piece bitboards.
+ *
+ * A 64-bit Zobrist key of the position (see zobrist.hpp) is computed once when the board is built and then updated
+ * with XORs by every method modifying the position.
+ *
+ * Additional game state is packed into one 8-byte State word (see Board::State):
  * - Active color (white to move or black to move)
  * - En passant target square (if available)
  * - Castling rights (white/black kingside/queenside)
  * - Halfmove clock (for 50-move rule)
  * - Fullmove number (increments after Black’s move)
  *
+ * The whole board is trivially copyable, so that search can either copy it per ply (copy-make) or play and take
+ * back moves in place (make_move()/unmake_move()); see bench_board_copy.
+ *
+ * The squares attacked by each side (attacked_squares()) are computed on demand and not stored, so that a const
+ * Board can be read by several threads at once; AttackMaps caches them on the caller's side.
+ *
  * The class provides utilities to query occupied squares,
- * retrieve/set/remove individual pieces, and print the board.
+ * retrieve/set/remove individual pieces, play and take back moves, and print the board.
  */
 class Board {
+ public:
+  /**
+   * @brief Castling rights bit flags, combined into a 4-bit mask.
+   */
+  enum CastlingRight : uint8_t {
+    WHITE_KINGSIDE = 1,
+    WHITE_QUEENSIDE = 2,
+    BLACK_KINGSIDE = 4,
+    BLACK_QUEENSIDE = 8,
+  };
+
+  /**
+   * @brief Non-bitboard game state, packed into a single aligned 64-bit word.
+   *
+   * Copied or restored with one load/store: make_move() saves it in UndoInfo and unmake_move() puts it back as is.
+   */
+  struct alignas(8) State {
+    uint8_t castling_rights;   ///< Mask of CastlingRight flags
+    uint8_t en_passant;        ///< En passant target square (0-63), NO_EN_PASSANT if none
+    uint8_t side_to_move;      ///< Piece::Color of the side to move
+    uint8_t reserved;          ///< Unused, always 0
+    uint16_t halfmove_clock;   ///< Halfmoves since the last pawn move or capture
+    uint16_t fullmove_number;  ///< Starts at 1, incremented after Black's move
+  };
+  static_assert(sizeof(State) == sizeof(uint64_t));
+
+  /** @brief State::en_passant value when there is no en passant target square. */
+  static constexpr uint8_t NO_EN_PASSANT = 64;
+
+  /**
+   * @brief Irreversible state saved by make_move() and needed by unmake_move() to restore the position.
+   *
+   * Search keeps one record per ply, typically as a local variable of its recursive function, so that
+   * making and unmaking moves never allocates nor copies the board.
+   */
+  struct UndoInfo {
+    uint64_t hash;         ///< Zobrist key before the move
+    State state;           ///< Game state before the move
+    Piece::Type captured;  ///< Captured piece, NO_PIECE if none
+  };
+
  private:
-  // Piece bitboards
-  Bitboard m_w_pawns, m_w_rooks, m_w_bishops, m_w_knights, m_w_king, m_w_queen;
-  Bitboard m_b_pawns, m_b_rooks, m_b_bishops, m_b_knights, m_b_king, m_b_queen;
+  // Piece bitboards, indexed by Piece::Type (NO_PIECE excluded)
+  std::array<Bitboard, 12> m_pieces;
+
+  // Occupancy caches, kept in sync by put_piece() and take_piece()
+  std::array<Bitboard, 2> m_colors;  ///< All pieces of each color, indexed by Piece::Color
+  Bitboard m_occupied;               ///< All pieces of both colors
+
+  // Piece type on each square, indexed by square (0-63), Piece::NO_PIECE if empty
+  std::array<Piece::Type, 64> m_mailbox;
+
+  // Side to move, castling rights, en passant square and clocks
+  State m_state;
+
+  // Zobrist key of the position
+  uint64_t m_hash;
+
+  /**
+   * @brief Places a piece on an empty square, updating occupancies, mailbox and hash.
+   */
+  void put_piece(Piece::Type type, Square sq);
 
-  // Game state
-  bool m_is_white_turn;                   ///< True if it is White's turn
-  std::optional<Square> m_en_passant_sq;  ///< En passant target square, or nullopt if none
+  /**
+   * @brief Removes the piece standing on an occupied square, updating occupancies, mailbox and hash.
+   */
+  void take_piece(Square sq);
+
+  /**
+   * @brief Moves the piece standing on `from` to the empty square `to`.
+   */
+  void move_piece(Square from, Square to);
 
-  // Castling abilities
-  bool m_white_castle_kingside;   ///< White may castle kingside
-  bool m_white_castle_queenside;  ///< White may castle queenside
-  bool m_black_castle_kingside;   ///< Black may castle kingside
-  bool m_black_castle_queenside;  ///< Black may castle queenside
+  /**
+   * @brief Checks if a pawn of the given color attacks the square skipped by a double push.
+   *
+   * The en passant square is only set (and hashed) when this holds, so that the same position always gets the same
+   * Zobrist key, whether it was reached by the double push or parsed from a FEN.
+   */
+  bool en_passant_capturable(Square skipped, Piece::Color capturer) const;
 
-  // 50-move rule state
-  int m_halfmove_clock;  ///< Counts halfmoves since last pawn move or capture
+  /** @brief Tag selecting the empty board constructor. */
+  struct EmptyTag {};
 
-  // Move number (starts at 1, incremented after Black’s move)
-  int m_fullmove_number;
+  /**
+   * @brief Constructs a board without pieces, White to move, no castling rights nor en passant square.
+   */
+  explicit Board(EmptyTag);
 
  public:
   /**
@@ -57,25 +148,73 @@ class Board {
   /**
    * @brief Constructs a board from a FEN string.
    * @param fen Forsyth–Edwards Notation describing a chess position.
+   * @throw std::invalid_argument when the FEN is invalid (see from_fen() for the non-throwing version)
+   *
+   * Stricter than it used to be: malformed fields, a missing or extra king, more than 16 pieces of a color, pawns
+   * on the back ranks and trailing characters that are not EPD operations are errors, where they were previously
+   * ignored or half-parsed.
    *
    * @see https://www.chess.com/terms/fen-chess
    */
   Board(const std::string& fen);
 
+  /**
+   * @brief Size of a buffer large enough for any FEN written by to_fen(), terminating null included.
+   */
+  static constexpr std::size_t MAX_FEN_LENGTH = 128;
+
+  /**
+   * @brief Parses a FEN string without allocating nor throwing.
+   * @param fen Forsyth–Edwards Notation: placement, side to move, castling rights, en passant square,
+   *            then optionally the halfmove clock and the fullmove number (0 and 1 when omitted, as in EPD),
+   *            then optionally EPD operations (`bm Nf3; id "x";`). Operations are skipped, except hmvc and fmvn
+   *            which set the clocks. Fields are separated by single spaces; no leading or trailing space is accepted.
+   * @return The position, or the first error found with its offset in `fen`.
+   *
+   * Meant for bulk loading (EPD files, datasets): pieces are placed directly and the Zobrist key is computed
+   * once at the end. Apart from requiring one king and at most 16 pieces per side and no pawn on the back ranks,
+   * the placement is not checked for chess legality (side not to move in check, impossible promotions...).
+   */
+  static std::expected<Board, FenError> from_fen(std::string_view fen);
+
+  /**
+   * @brief Writes the FEN of the position into a caller-supplied buffer.
+   * @param buffer Destination, at least MAX_FEN_LENGTH characters to fit any position.
+   * @return Number of characters written (a terminating null is added if there is room), 0 if `buffer`
+   *         is too small for this position.
+   */
+  std::size_t to_fen(std::span<char> buffer) const;
+
+  /**
+   * @brief Returns the FEN of the position.
+   */
+  std::string to_fen() const;
+
   /**
    * @brief Returns a bitboard containing all white pieces.
    */
-  Bitboard white_pieces() const;
+  Bitboard white_pieces() const { return m_colors[Piece::WHITE]; }
 
   /**
    * @brief Returns a bitboard containing all black pieces.
    */
-  Bitboard black_pieces() const;
+  Bitboard black_pieces() const { return m_colors[Piece::BLACK]; }
+
+  /**
+   * @brief Returns a bitboard containing all pieces of the given color.
+   */
+  Bitboard pieces(Piece::Color color) const { return m_colors[color]; }
+
+  /**
+   * @brief Returns the bitboard of the given piece type.
+   * @param type Piece type (including color), NO_PIECE excluded.
+   */
+  Bitboard pieces(Piece::Type type) const { return m_pieces[type]; }
 
   /**
    * @brief Returns a bitboard containing all occupied squares (both sides).
    */
-  Bitboard occupied() const;
+  Bitboard occupied() const { return m_occupied; }
 
   /**
    * @brief Retrieves the piece on a given square.
@@ -97,6 +236,137 @@ class Board {
    */
   void remove_piece(Square sq);
 
+  /**
+   * @brief Checks if White is to move.
+   */
+  bool is_white_turn() const { return m_state.side_to_move == Piece::WHITE; }
+
+  /**
+   * @brief Returns the color of the side to move.
+   */
+  Piece::Color side_to_move() const { return static_cast<Piece::Color>(m_state.side_to_move); }
+
+  /**
+   * @brief Sets the side to move.
+   * @param is_white_turn True if White is to move.
+   */
+  void set_white_turn(bool is_white_turn);
+
+  /**
+   * @brief Returns the castling rights as a mask of CastlingRight flags.
+   */
+  uint8_t castling_rights() const { return m_state.castling_rights; }
+
+  /**
+   * @brief Sets the castling rights.
+   * @param rights Mask of CastlingRight flags.
+   */
+  void set_castling_rights(uint8_t rights);
+
+  /**
+   * @brief Returns the en passant target square, or nullopt if none.
+   */
+  std::optional<Square> en_passant_square() const {
+    if (m_state.en_passant == NO_EN_PASSANT) return std::nullopt;
+    return Square::unchecked(m_state.en_passant);
+  }
+
+  /**
+   * @brief Sets (or clears with nullopt) the en passant target square.
+   */
+  void set_en_passant_square(std::optional<Square> sq);
+
+  /**
+   * @brief Returns the number of halfmoves since the last pawn move or capture.
+   */
+  int halfmove_clock() const { return m_state.halfmove_clock; }
+
+  /**
+   * @brief Returns the fullmove number (starts at 1, incremented after Black's move).
+   */
+  int fullmove_number() const { return m_state.fullmove_number; }
+
+  /**
+   * @brief Returns the Zobrist key of the position, maintained incrementally.
+   */
+  uint64_t hash() const { return m_hash; }
+
+  /**
+   * @brief Computes the Zobrist key of the position from scratch.
+   *
+   * Slow (loops over all pieces), meant for initialization and for checking the incremental key in tests.
+   */
+  uint64_t compute_hash() const;
+
+  /**
+   * @brief Returns the square of the king of the given color.
+   */
+  Square king_square(Piece::Color color) const;
+
+  /**
+   * @brief Checks if a square is attacked by any piece of the given color.
+   * @param sq The square to test.
+   * @param by Color of the attacking side.
+   */
+  bool is_square_attacked(Square sq, Piece::Color by) const;
+
+  /**
+   * @brief Returns the pieces of both colors attacking a square.
+   * @param sq The square to test.
+   * @param occ Occupancy blocking the sliders, e.g. occupied() with some pieces removed to look through them.
+   * @return Attackers among the pieces on the board; mask with pieces(color) to keep one side.
+   *
+   * Pieces missing from `occ` still attack; callers looking through a piece usually mask it out of the result.
+   */
+  Bitboard attackers_to(Square sq, Bitboard occ) const;
+
+  /**
+   * @brief Returns the pieces of both colors attacking a square with the current occupancy.
+   */
+  Bitboard attackers_to(Square sq) const { return attackers_to(sq, m_occupied); }
+
+  /**
+   * @brief Returns all squares attacked by the pieces of one color (occupied squares included).
+   *
+   * Computed from scratch on every call: worth it when many squares are queried at once (king safety, castling
+   * paths); for a single square, is_square_attacked() is cheaper. Use AttackMaps to reuse the maps of a position.
+   */
+  Bitboard attacked_squares(Piece::Color by) const;
+
+  /**
+   * @brief Checks if the king of the side to move is in check.
+   */
+  bool in_check() const;
+
+  /**
+   * @brief Plays a move for the side to move.
+   * @param move A pseudo-legal move in this position.
+   * @return State needed by unmake_move() to take the move back.
+   *
+   * Updates the pieces, castling rights, en passant square, clocks, side to move and hash.
+   * The en passant square is only set after a double push if an enemy pawn can actually capture,
+   * so that positions without a possible en passant capture share the same hash.
+   */
+  UndoInfo make_move(Move move);
+
+  /**
+   * @brief Takes back the last move played with make_move().
+   * @param move The move to take back.
+   * @param undo The record returned by make_move() for that move.
+   */
+  void unmake_move(Move move, const UndoInfo& undo);
+
+  /**
+   * @brief Checks that the mailbox and the piece bitboards describe the same position.
+   *
+   * Every square must be set in exactly the bitboard of the piece stored in the mailbox, and in no bitboard if the
+   * mailbox entry is NO_PIECE. The cached color and total occupancies must match the union of the piece bitboards.
+   * Debug builds assert this after every modification.
+   *
+   * @return true if all representations agree.
+   */
+  bool is_consistent() const;
+
   /**
    * @brief Prints the board to the given output stream.
    *
@@ -114,4 +384,36 @@ class Board {
    * @endcode
    */
   void print() const;
+};
+
+// Published layout: 12 piece bitboards, 2 color occupancies and the total occupancy (120 bytes), the mailbox
+// (64 bytes), the state word and the Zobrist key (8 bytes each)
+static_assert(sizeof(Board) == 200);
+
+/**
+ * @class AttackMaps
+ * @brief Caller-side cache of the squares attacked by each side, for the last position queried per side.
+ *
+ * Kept outside Board so that copies stay small and a const Board stays safe to share between threads: each
+ * search thread owns its AttackMaps. A map is reused while the position has the same Zobrist key, so any edit or
+ * move recomputes it on the next query (as does a change of side to move, castling rights or en passant square).
+ */
+class AttackMaps {
+ private:
+  std::array<uint64_t, 2> m_keys{};
+  std::array<Bitboard, 2> m_maps{};
+  std::array<bool, 2> m_valid{};
+
+ public:
+  /**
+   * @brief Returns Board::attacked_squares(by), computed only if `board` is not the position of the last call.
+   */
+  Bitboard attacked_squares(const Board& board, Piece::Color by) {
+    if (!m_valid[by] || m_keys[by] != board.hash()) {
+      m_maps[by] = board.attacked_squares(by);
+      m_keys[by] = board.hash();
+      m_valid[by] = true;
+    }
+    return m_maps[by];
+  }
 };
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+#include <array>
+#include <chess_engine/board.hpp>
+#include <chess_engine/piece.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @class BoardBatch
+ * @brief Piece bitboards of many independent positions, stored as a struct of arrays.
+ *
+ * Bitboards of the same piece type are contiguous across positions: pieces(Piece::P)[i] is the white pawn
+ * bitboard of the i-th position. Kernels (see BatchKernels) can therefore load the same piece type of several
+ * consecutive positions into one SIMD register and process them in lockstep, e.g. 4 positions per AVX2 register.
+ *
+ * Only piece placement is kept: side to move, castling rights and clocks play no part in the batch kernels.
+ */
+class BoardBatch {
+ private:
+  std::array<std::vector<uint64_t>, 12> m_pieces;
+
+ public:
+  /** @brief Returns the number of positions. */
+  std::size_t size() const { return m_pieces[0].size(); }
+
+  /** @brief Checks if the batch holds no position. */
+  bool empty() const { return m_pieces[0].empty(); }
+
+  /** @brief Reserves room for a number of positions. */
+  void reserve(std::size_t capacity);
+
+  /** @brief Removes all positions. */
+  void clear();
+
+  /** @brief Appends the piece placement of a board. */
+  void push_back(const Board& board);
+
+  /**
+   * @brief Returns the bitboards of one piece type, one per position.
+   * @param type Piece type (including color), NO_PIECE excluded.
+   */
+  std::span<const uint64_t> pieces(Piece::Type type) const { return m_pieces[type]; }
+};
+
+/**
+ * @namespace BatchKernels
+ * @brief Attack and occupancy kernels computing one bitboard per position of a BoardBatch.
+ *
+ * Each kernel writes out[i] for every position i of the batch; `out` must hold at least batch.size() values.
+ *
+ * Two interchangeable backends:
+ * - Backend::Scalar: one position at a time with 64-bit operations, portable
+ * - Backend::Avx2: four positions per 256-bit register; positions left over after the last full group of four
+ *   go through the scalar code
+ *
+ * The backend is picked once at startup: AVX2 when Cpu::has_avx2() is true, scalar otherwise.
+ * The AVX2 code is compiled with a per-function target attribute, the rest of the library keeps its baseline.
+ */
+namespace BatchKernels {
+
+/**
+ * @brief Kernel implementations.
+ */
+enum class Backend { Scalar, Avx2 };
+
+/**
+ * @brief Returns the backend currently used by the kernels.
+ */
+Backend backend();
+
+/**
+ * @brief Returns a printable name for a backend ("scalar" or "avx2").
+ */
+const char* backend_name(Backend backend);
+
+/**
+ * @brief Checks if a backend can run on this build and CPU.
+ */
+bool backend_supported(Backend backend);
+
+/**
+ * @brief Switches to another backend.
+ * @param backend Backend to activate.
+ * @return false (and keeps the current backend) if `backend` is not supported.
+ *
+ * Meant for tests and benchmarks. Not thread-safe: no kernel may be running meanwhile.
+ */
+bool select_backend(Backend backend);
+
+/**
+ * @brief Squares occupied by the pieces of one color.
+ */
+void occupancy(const BoardBatch& batch, Piece::Color color, std::span<uint64_t> out);
+
+/**
+ * @brief Squares occupied by the pieces of both colors.
+ */
+void occupancy(const BoardBatch& batch, std::span<uint64_t> out);
+
+/**
+ * @brief Squares attacked by the pawns of one color (shifts masked with the A/H files to avoid wrapping).
+ */
+void pawn_attacks(const BoardBatch& batch, Piece::Color color, std::span<uint64_t> out);
+
+/**
+ * @brief Squares attacked along ranks and files by the rooks and queens of one color (set-wise fills).
+ */
+void rook_attacks(const BoardBatch& batch, Piece::Color color, std::span<uint64_t> out);
+
+/**
+ * @brief Squares attacked along diagonals by the bishops and queens of one color (set-wise fills).
+ */
+void bishop_attacks(const BoardBatch& batch, Piece::Color color, std::span<uint64_t> out);
+
+}  // namespace BatchKernels
@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * @namespace Cpu
+ * @brief Runtime detection of optional instruction set extensions.
+ *
+ * The library is compiled for the baseline of its target architecture. Faster code paths relying on newer
+ * instructions are selected at startup by querying the running CPU (CPUID on x86-64).
+ * On other architectures, every query returns false.
+ */
+namespace Cpu {
+
+/**
+ * @brief Checks if the running CPU supports BMI2 (PEXT, PDEP, ...).
+ */
+bool has_bmi2();
+
+/**
+ * @brief Checks if the running CPU implements PEXT in hardware at full speed.
+ *
+ * AMD Zen 1 and Zen 2 (family 0x17) report BMI2 but execute PEXT in microcode, with a latency of up to several
+ * hundred cycles depending on the mask. Those CPUs are better off with multiply-shift magics.
+ */
+bool has_fast_pext();
+
+/**
+ * @brief Checks if AVX2 instructions can be used: supported by the CPU and its 256-bit state saved by the OS.
+ */
+bool has_avx2();
+
+}  // namespace Cpu
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Reason and location of a FEN parsing failure, returned by Board::from_fen().
+ *
+ * Parsing stops at the first error: `offset` is the index in the input of the character (or the field)
+ * that could not be accepted, so that a caller can point at it without the parser allocating a message.
+ */
+struct FenError {
+  /** @brief What went wrong, one value per field and failure kind. */
+  enum Code : uint8_t {
+    MISSING_FIELD,          ///< Input ends before the side to move, castling or en passant field
+    INVALID_PIECE,          ///< Placement character that is neither a piece, a digit 1-8 nor '/'
+    INVALID_RANK_SIZE,      ///< A rank does not describe exactly 8 squares
+    INVALID_RANK_COUNT,     ///< Placement does not describe exactly 8 ranks
+    INVALID_PAWN_RANK,      ///< Pawn on the 1st or 8th rank
+    INVALID_KING_COUNT,     ///< Placement does not have exactly one king of each color
+    INVALID_PIECE_COUNT,    ///< Placement has more than 16 pieces of one color
+    INVALID_SIDE,           ///< Side to move is neither 'w' nor 'b'
+    INVALID_CASTLING,       ///< Castling field is neither '-' nor a combination of 'K', 'Q', 'k', 'q'
+    INVALID_EN_PASSANT,     ///< En passant field is neither '-' nor a square on the 3rd or 6th rank
+    INVALID_CLOCK,          ///< Halfmove clock or fullmove number is not a number in range
+    INVALID_EPD_OPERATION,  ///< EPD operation not starting with an opcode or not ended by ';'
+    TRAILING_CHARACTERS,    ///< Unexpected characters after the last field
+  };
+
+  Code code;
+  std::size_t offset;
+
+  /** @brief Returns a static, human readable description of the error code. */
+  const char* message() const;
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include <chess_engine/piece.hpp>
+#include <chess_engine/square.hpp>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Represents a chess move packed in 16 bits.
+ *
+ * Layout:
+ *
+ *   bits 15-14   bits 13-12       bits 11-6     bits 5-0
+ *   type         promotion        to square     from square
+ *
+ * - type: NORMAL, PROMOTION, EN_PASSANT or CASTLING
+ * - promotion: promoted piece kind, 0 = knight, 1 = bishop, 2 = rook, 3 = queen (only meaningful for PROMOTION)
+ *
+ * Castling is encoded as the king move (e.g. e1g1), the rook move is implied.
+ * Captures are not flagged: a move is a capture if its destination square is occupied (or if it is en passant).
+ *
+ * The all-zero value (a1a1) is never a legal move and is used as the "no move" value.
+ */
+class Move {
+ public:
+  /** @brief Enum for special move types, already shifted in place. */
+  enum Type : uint16_t {
+    NORMAL = 0,
+    PROMOTION = 1 << 14,
+    EN_PASSANT = 2 << 14,
+    CASTLING = 3 << 14,
+  };
+
+ private:
+  uint16_t m_data;
+
+ public:
+  /** @brief Constructs the null move. */
+  constexpr Move() : m_data(0) {}
+
+  /**
+   * @brief Constructs a non-promotion move.
+   * @param from Origin square.
+   * @param to Destination square.
+   * @param type NORMAL, EN_PASSANT or CASTLING.
+   */
+  constexpr Move(Square from, Square to, Type type = NORMAL)
+      : m_data(static_cast<uint16_t>(type | (to.value() << 6) | from.value())) {}
+
+  /**
+   * @brief Constructs a promotion move.
+   * @param from Origin square.
+   * @param to Destination square.
+   * @param promotion Promoted piece type, of either color (N, B, R, Q or n, b, r, q).
+   */
+  static constexpr Move make_promotion(Square from, Square to, Piece::Type promotion) {
+    Move move(from, to, PROMOTION);
+    move.m_data |= static_cast<uint16_t>(((promotion % 6) - Piece::N) << 12);
+    return move;
+  }
+
+  /**
+   * @brief Rebuilds a move from its raw 16-bit value.
+   * @param raw Value returned by raw().
+   */
+  static constexpr Move from_raw(uint16_t raw) {
+    Move move;
+    move.m_data = raw;
+    return move;
+  }
+
+  /** @brief Returns the origin square. */
+  constexpr Square from() const { return Square::unchecked(m_data & 0x3F); }
+
+  /** @brief Returns the destination square. */
+  constexpr Square to() const { return Square::unchecked((m_data >> 6) & 0x3F); }
+
+  /** @brief Returns the move type. */
+  constexpr Type type() const { return static_cast<Type>(m_data & (3 << 14)); }
+
+  /**
+   * @brief Returns the promoted piece type for the given color.
+   * @param color Color of the side making the move.
+   * @return Piece type of the promoted piece, only meaningful for PROMOTION moves.
+   */
+  constexpr Piece::Type promotion_type(Piece::Color color) const {
+    return static_cast<Piece::Type>(Piece::N + ((m_data >> 12) & 3) + (color == Piece::BLACK ? Piece::p : Piece::P));
+  }
+
+  /** @brief Returns the raw 16-bit value. */
+  constexpr uint16_t raw() const { return m_data; }
+
+  /** @brief Checks if this is the null move. */
+  constexpr bool is_null() const { return m_data == 0; }
+
+  /**
+   * @brief Converts the move to UCI long algebraic notation.
+   * @return String like "e2e4", "e7e8q" or "e1g1" (castling).
+   */
+  std::string to_uci() const {
+    std::string uci = from().to_string() + to().to_string();
+    if (type() == PROMOTION) uci += "nbrq"[(m_data >> 12) & 3];
+    return uci;
+  }
+
+  constexpr bool operator==(const Move& other) const { return m_data == other.m_data; }
+  constexpr bool operator!=(const Move& other) const { return m_data != other.m_data; }
+};
@@ -0,0 +1,216 @@
+#pragma once
+#include <array>
+#include <chess_engine/board.hpp>
+#include <chess_engine/move.hpp>
+#include <chess_engine/movegen.hpp>
+#include <chess_engine/piece.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @namespace MoveOrdering
+ * @brief Move scores for alpha-beta: the earlier the best move is tried, the more of the tree is cut off.
+ *
+ * Moves are ranked in bands, each band above all the following ones:
+ * 1. the hash move (best move stored in the transposition table, or of the previous iteration);
+ * 2. winning and equal captures (SEE >= 0) and queen promotions, most valuable victim / least valuable attacker;
+ * 3. the two killer moves of the ply (quiet moves that caused a cutoff in a sibling node);
+ * 4. the counter move (quiet move that last refuted the previous move);
+ * 5. other quiet moves, by butterfly history plus continuation history;
+ * 6. losing captures, most valuable victim first.
+ *
+ * @see https://www.chessprogramming.org/Move_Ordering
+ */
+namespace MoveOrdering {
+
+constexpr int HASH_MOVE_SCORE = 1 << 30;
+constexpr int GOOD_CAPTURE_SCORE = 1 << 28;
+constexpr int KILLER_SCORE = 1 << 27;
+constexpr int COUNTER_MOVE_SCORE = 1 << 26;
+constexpr int BAD_CAPTURE_SCORE = -(1 << 28);
+
+/** @brief Bound of each history table entry; quiet move scores stay within twice this value. */
+constexpr int HISTORY_MAX = 16384;
+
+/**
+ * @brief Checks if a move changes the material balance: a capture, en passant or a queen promotion.
+ *
+ * Under-promotions are treated as quiet moves.
+ */
+bool is_tactical(const Board& board, Move move);
+
+/**
+ * @brief Most valuable victim / least valuable attacker rank of a tactical move, higher first and below 128.
+ *
+ * A queen promotion counts as capturing a queen, on top of what it captures.
+ */
+int mvv_lva(const Board& board, Move move);
+
+/**
+ * @brief Score of a tactical move: in the good capture band if SEE does not lose material, the bad one otherwise.
+ */
+int tactical_score(const Board& board, Move move);
+
+}  // namespace MoveOrdering
+
+/**
+ * @class History
+ * @brief Move ordering statistics gathered during a search, private to one search thread.
+ *
+ * - killers: per ply, the last two quiet moves that caused a beta cutoff;
+ * - counter moves: per (piece, destination) of the previous move, the quiet move that refuted it;
+ * - butterfly history: per (color, origin, destination), how often a quiet move caused a cutoff;
+ * - continuation history: per (piece, destination) of the previous move and (piece, destination) of the
+ *   reply, the same statistic in the context of the previous move.
+ *
+ * History entries get a depth-dependent bonus when their move causes a cutoff and the same malus for each quiet
+ * move searched before it without success. Updates are scaled down as an entry approaches HISTORY_MAX ("history
+ * gravity"), so entries stay bounded and recent results weigh more than old ones.
+ *
+ * The continuation table takes about 1.2 MB: allocate History on the heap.
+ */
+class History {
+ public:
+  /** @brief Deepest ply with killer moves. */
+  static constexpr int MAX_PLY = 256;
+
+  /**
+   * @brief Piece and destination of the previous move, the context of the counter move and continuation history.
+   */
+  struct PieceTo {
+    Piece::Type piece = Piece::NO_PIECE;  ///< Moved piece, NO_PIECE if there is no previous move
+    Square to{Square::A1};
+  };
+
+  /** @brief Returns the context of a move, given the position before it. */
+  static PieceTo piece_to(const Board& board, Move move) { return {board.get_piece(move.from()).type(), move.to()}; }
+
+ private:
+  std::array<std::array<Move, 2>, MAX_PLY> m_killers;
+  std::array<std::array<Move, 64>, 12> m_counter_moves;
+  std::array<std::array<std::array<int16_t, 64>, 64>, 2> m_butterfly;
+  std::array<std::array<std::array<std::array<int16_t, 64>, 12>, 64>, 12> m_continuation;
+
+  static void apply(int16_t& entry, int bonus);
+
+ public:
+  History() { clear(); }
+
+  /** @brief Forgets all statistics. */
+  void clear();
+
+  /** @brief Returns a killer move of a ply (slot 0 is the most recent), the null move if none. */
+  Move killer(int ply, int slot) const { return m_killers[ply][slot]; }
+
+  /** @brief Returns the counter move of the previous move, the null move if none. */
+  Move counter_move(PieceTo previous) const {
+    return previous.piece == Piece::NO_PIECE ? Move() : m_counter_moves[previous.piece][previous.to.value()];
+  }
+
+  /** @brief Returns the history score of a quiet move, in [-2 * HISTORY_MAX, 2 * HISTORY_MAX]. */
+  int quiet_score(const Board& board, Move move, PieceTo previous) const;
+
+  /**
+   * @brief Records a beta cutoff caused by a quiet move.
+   * @param board Position of the node.
+   * @param best Quiet move that caused the cutoff.
+   * @param tried Quiet moves searched before it, which get a malus.
+   * @param depth Remaining depth of the node, the larger the bigger the update.
+   * @param ply Distance of the node from the root.
+   * @param previous Context of the move leading to the node.
+   */
+  void update(const Board& board, Move best, std::span<const Move> tried, int depth, int ply, PieceTo previous);
+};
+
+/**
+ * @class MovePicker
+ * @brief Staged move generation for one search node: each kind of move is generated and scored only once the
+ * earlier kinds have failed to cut the node off.
+ *
+ * Stages, in the order of the MoveOrdering bands:
+ * 1. HASH_MOVE: the hash move, validated with MoveGen::is_legal() and returned before anything is generated;
+ * 2. GOOD_CAPTURES: captures are generated (MoveGen::generate_captures()) and scored with tactical_score(); those
+ *    not losing material come out best first;
+ * 3. REFUTATIONS: the killer moves of the ply, then the counter move, each validated with MoveGen::is_legal();
+ * 4. QUIETS: quiet moves are generated (MoveGen::generate_quiets()) and come out by history score;
+ * 5. BAD_CAPTURES: the captures losing material, left over from stage 2.
+ *
+ * Moves returned by an earlier stage are skipped later, so each legal move comes out exactly once. Most nodes are
+ * cut off by the hash move or a capture, before the quiet moves, the bulk of the list, are generated at all.
+ * Within a stage, moves are picked by selection rather than sorted up front.
+ *
+ * The board is referenced, not copied: it must be in the same position whenever next() is called.
+ */
+class MovePicker {
+ public:
+  /** @brief Progress of the picker; GENERATE_* stages are transient. */
+  enum Stage : uint8_t {
+    HASH_MOVE,
+    GENERATE_CAPTURES,
+    GOOD_CAPTURES,
+    REFUTATIONS,
+    GENERATE_QUIETS,
+    QUIETS,
+    BAD_CAPTURES,
+    DONE
+  };
+
+ private:
+  const Board& m_board;
+  const History* m_history = nullptr;
+  History::PieceTo m_previous;
+  Move m_hash_move;
+  bool m_captures_only = false;
+  Stage m_stage = HASH_MOVE;
+
+  /** Killer moves then counter move, legal quiet moves distinct from the hash move and from each other. */
+  std::array<Move, 3> m_refutations;
+  std::size_t m_refutation = 0;
+
+  /** Captures at the front, quiet moves appended once generated. */
+  MoveList m_moves;
+  std::array<int, MoveList::CAPACITY> m_scores;
+  std::size_t m_current = 0;       ///< Next move of the current stage
+  std::size_t m_end = 0;           ///< End of the moves of the current stage
+  std::size_t m_bad_captures = 0;  ///< First capture losing material
+  std::size_t m_captures_end = 0;
+
+  /** Returns the best move of [m_current, m_end) after swapping it to m_current, and moves past it. */
+  Move pick_best() {
+    std::size_t best = m_current;
+    for (std::size_t i = m_current + 1; i < m_end; ++i) {
+      if (m_scores[i] > m_scores[best]) best = i;
+    }
+    std::swap(m_moves[best], m_moves[m_current]);
+    std::swap(m_scores[best], m_scores[m_current]);
+    return m_moves[m_current++];
+  }
+
+  bool is_refutation(Move move) const {
+    return move == m_refutations[0] || move == m_refutations[1] || move == m_refutations[2];
+  }
+
+ public:
+  /**
+   * @brief Prepares a picker for all legal moves of a node.
+   * @param board Position the moves are played from.
+   * @param hash_move Move to try first, may be null or illegal in `board` (it is then ignored).
+   * @param history Killer, counter move and history statistics, or nullptr to return quiet moves in generation
+   * order.
+   * @param ply Distance of the node from the root, for the killer moves.
+   * @param previous Context of the move leading to the node.
+   */
+  MovePicker(const Board& board, Move hash_move, const History* history, int ply, History::PieceTo previous);
+
+  /**
+   * @brief Prepares a picker for the captures of a node only (good ones, then losing ones), for quiescence search.
+   */
+  explicit MovePicker(const Board& board) : m_board(board), m_captures_only(true), m_stage(GENERATE_CAPTURES) {}
+
+  /** @brief Returns the next move, or the null move once all moves are handed out. */
+  Move next();
+
+  /** @brief Returns the current stage of the picker, DONE once all moves are handed out. */
+  Stage stage() const { return m_stage; }
+};
@@ -0,0 +1,120 @@
+#pragma once
+#include <array>
+#include <chess_engine/board.hpp>
+#include <chess_engine/move.hpp>
+#include <cstddef>
+
+/**
+ * @class MoveList
+ * @brief Fixed-capacity list of moves, meant to live on the stack.
+ *
+ * The capacity of 256 is above the largest known number of legal moves in a chess position (218),
+ * so generating moves never needs to allocate.
+ */
+class MoveList {
+ public:
+  /** @brief Maximum number of moves a list can hold. */
+  static constexpr std::size_t CAPACITY = 256;
+
+ private:
+  std::array<Move, CAPACITY> m_moves;
+  std::size_t m_size = 0;
+
+ public:
+  /** @brief Appends a move (no bounds check, the capacity covers any chess position). */
+  constexpr void push_back(Move move) { m_moves[m_size++] = move; }
+
+  /** @brief Removes all moves. */
+  constexpr void clear() { m_size = 0; }
+
+  /** @brief Returns the number of moves. */
+  constexpr std::size_t size() const { return m_size; }
+
+  /** @brief Checks if the list holds no move. */
+  constexpr bool empty() const { return m_size == 0; }
+
+  /** @brief Checks if the list holds the given move. */
+  constexpr bool contains(Move move) const {
+    for (std::size_t i = 0; i < m_size; ++i) {
+      if (m_moves[i] == move) return true;
+    }
+    return false;
+  }
+
+  constexpr Move& operator[](std::size_t index) { return m_moves[index]; }
+  constexpr const Move& operator[](std::size_t index) const { return m_moves[index]; }
+
+  constexpr Move* begin() { return m_moves.data(); }
+  constexpr Move* end() { return m_moves.data() + m_size; }
+  constexpr const Move* begin() const { return m_moves.data(); }
+  constexpr const Move* end() const { return m_moves.data() + m_size; }
+};
+
+/**
+ * @namespace MoveGen
+ * @brief Move generation from a Board.
+ */
+namespace MoveGen {
+
+/**
+ * @brief Generates all pseudo-legal moves of the side to move.
+ * @param board Position to generate moves for.
+ * @param moves List to append the moves to.
+ *
+ * Pseudo-legal moves follow the movement rules of each piece but may leave the own king in check.
+ * Castling is only generated when the king is not in check and does not cross an attacked square;
+ * whether the king lands on an attacked square is left to the legality check, like every other move.
+ *
+ * Covers pawn pushes, double pushes, captures, en passant and promotions (all four pieces),
+ * knight, bishop, rook, queen and king moves, and castling on both sides.
+ */
+void generate_pseudo_legal(const Board& board, MoveList& moves);
+
+/**
+ * @brief Generates all legal moves of the side to move.
+ * @param board Position to generate moves for.
+ * @param moves List to append the moves to.
+ *
+ * Legality is established up front instead of with make/unmake:
+ * - checkers: enemy pieces attacking the king; in double check only king moves are generated;
+ * - check mask: in single check, other pieces must capture the checker or land between it and the king;
+ * - pins: a piece alone between the king and an enemy slider only moves along that line;
+ * - king moves: the destination is tested with the king removed from the occupancy, so it cannot hide
+ *   behind itself from a slider;
+ * - en passant: the position after the capture is checked for a slider attack on the king, which covers
+ *   the rank where both pawns leave at once (e.g. "8/8/8/K2pP2r/8/8/8/7k w - d6").
+ */
+void generate_legal(const Board& board, MoveList& moves);
+
+/**
+ * @brief Generates the legal captures of the side to move: captures, en passant and queen promotions.
+ * @param board Position to generate moves for.
+ * @param moves List to append the moves to.
+ *
+ * Promotions with a capture are captures whatever the promoted piece. Together with generate_quiets(), splits
+ * the moves of generate_legal() in two disjoint sets, so that a search can generate quiet moves only when the
+ * captures did not cut the node off. The split matches MoveOrdering::is_tactical().
+ */
+void generate_captures(const Board& board, MoveList& moves);
+
+/**
+ * @brief Generates the legal quiet moves of the side to move: the legal moves generate_captures() leaves out.
+ * @param board Position to generate moves for.
+ * @param moves List to append the moves to.
+ *
+ * Covers pushes, under-promotions without capture, piece moves to empty squares and castling.
+ */
+void generate_quiets(const Board& board, MoveList& moves);
+
+/**
+ * @brief Checks if a move is legal in a position, without generating the moves.
+ * @param board Position to play the move in.
+ * @param move Any move value, e.g. read from a transposition table entry that may belong to another position.
+ * @return True if generate_legal() would generate the move.
+ *
+ * Meant for moves known before generation (hash move, killer moves), which a search tries first and whose
+ * legality it must establish on its own.
+ */
+bool is_legal(const Board& board, Move move);
+
+}  // namespace MoveGen
@@ -0,0 +1,152 @@
+#pragma once
+#include <atomic>
+#include <chess_engine/board.hpp>
+#include <chess_engine/move.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class PerftHashTable
+ * @brief Lock-free cache of subtree node counts, keyed by (Zobrist key, depth), shared by all perft threads.
+ *
+ * Each entry holds two 64-bit words written independently with relaxed atomics:
+ * - data: node count (upper 56 bits) and depth (lower 8 bits);
+ * - check: Zobrist key XOR data.
+ *
+ * A probe only accepts an entry if check XOR data gives back the probed key, so an entry torn by two threads
+ * writing concurrently is rejected instead of returning a wrong count (the "lockless hashing" XOR trick).
+ * Entries are always replaced on store.
+ */
+class PerftHashTable {
+ private:
+  struct Entry {
+    std::atomic<uint64_t> check{0};
+    std::atomic<uint64_t> data{0};
+  };
+
+  std::unique_ptr<Entry[]> m_entries;
+  uint64_t m_mask;
+
+  /** @brief Index of the slot of a (key, depth) pair; depths of the same position land in different slots. */
+  std::size_t index(uint64_t key, int depth) const {
+    return static_cast<std::size_t>((key ^ (static_cast<uint64_t>(depth) * 0x9E3779B97F4A7C15ULL)) & m_mask);
+  }
+
+ public:
+  /**
+   * @brief Allocates a cleared table.
+   * @param megabytes Memory budget, rounded down to a power of two number of 16-byte entries (at least one).
+   */
+  explicit PerftHashTable(std::size_t megabytes);
+
+  /** @brief Returns the number of entries. */
+  std::size_t size() const { return static_cast<std::size_t>(m_mask + 1); }
+
+  /** @brief Empties the table. */
+  void clear();
+
+  /**
+   * @brief Looks up the node count of a position at a given depth.
+   * @param key Zobrist key of the position.
+   * @param depth Remaining depth.
+   * @param nodes Set to the cached count on a hit.
+   * @return True on a hit.
+   */
+  bool probe(uint64_t key, int depth, uint64_t& nodes) const {
+    const Entry& entry = m_entries[index(key, depth)];
+    const uint64_t data = entry.data.load(std::memory_order_relaxed);
+    const uint64_t check = entry.check.load(std::memory_order_relaxed);
+    if ((check ^ data) != key || static_cast<int>(data & 0xFF) != depth) return false;
+    nodes = data >> 8;
+    return true;
+  }
+
+  /**
+   * @brief Stores the node count of a position at a given depth.
+   * @param key Zobrist key of the position.
+   * @param depth Remaining depth (below 256).
+   * @param nodes Node count (below 2^56).
+   */
+  void store(uint64_t key, int depth, uint64_t nodes) {
+    Entry& entry = m_entries[index(key, depth)];
+    const uint64_t data = (nodes << 8) | static_cast<uint64_t>(depth);
+    entry.check.store(key ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @namespace Perft
+ * @brief Move path enumeration, used to validate and benchmark move generation.
+ *
+ * Perft counts the leaf nodes of the legal move tree up to a given depth. Comparing the counts
+ * against published reference values catches nearly every move generation bug.
+ *
+ * @see https://www.chessprogramming.org/Perft
+ */
+namespace Perft {
+
+/**
+ * @brief Node count below a single root move.
+ */
+struct DivideEntry {
+  Move move;
+  uint64_t nodes;
+};
+
+/**
+ * @brief Counts the leaf nodes of the legal move tree.
+ * @param board Position to start from, restored before returning.
+ * @param depth Number of plies to search (0 counts the position itself).
+ * @return Number of leaf nodes.
+ *
+ * Leaves are counted in bulk: at depth 1 the size of the legal move list is returned
+ * instead of making and unmaking every move.
+ */
+uint64_t perft(Board& board, int depth);
+
+/**
+ * @brief Counts the leaf nodes below each legal root move.
+ * @param board Position to start from, restored before returning.
+ * @param depth Number of plies to search, at least 1.
+ * @return One entry per legal root move, in generation order. The entries sum up to perft(board, depth).
+ */
+std::vector<DivideEntry> divide(Board& board, int depth);
+
+/**
+ * @brief Hash table usage counters of a perft run.
+ */
+struct HashStats {
+  uint64_t probes = 0;
+  uint64_t hits = 0;
+};
+
+/**
+ * @brief Counts the leaf nodes of the legal move tree, caching subtree counts in a hash table.
+ * @param board Position to start from, restored before returning.
+ * @param depth Number of plies to search.
+ * @param table Table to probe and fill (positions at depth 2 and more; depth 1 is counted in bulk).
+ * @param stats Counters incremented with the probes made by this call.
+ * @return Number of leaf nodes.
+ */
+uint64_t perft(Board& board, int depth, PerftHashTable& table, HashStats& stats);
+
+/**
+ * @brief Counts the leaf nodes below each legal root move using several threads.
+ * @param board Position to start from.
+ * @param depth Number of plies to search, at least 1.
+ * @param threads Number of worker threads (0 is treated as 1).
+ * @param table Optional table shared by all threads, nullptr to disable caching.
+ * @param stats Optional counters receiving the hash probes of all threads.
+ * @return One entry per legal root move, in generation order.
+ *
+ * The tree is split into one task per (root move, reply) pair, or per root move below depth 3.
+ * Tasks are dealt round-robin to per-thread deques; a thread pops from the back of its own deque and,
+ * once empty, steals from the front of the others, which keeps threads busy when subtree sizes differ.
+ */
+std::vector<DivideEntry> divide(const Board& board, int depth, unsigned threads, PerftHashTable* table,
+                                HashStats* stats = nullptr);
+
+}  // namespace Perft
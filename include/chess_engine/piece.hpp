@@ -1,8 +1,12 @@
 #pragma once
 #include <fmt/core.h>
 
+#include <array>
 #include <cctype>
+#include <cstdint>
+#include <optional>
 #include <stdexcept>
+#include <string>
 
 /**
  * @brief Represents a chess piece.
@@ -14,55 +18,117 @@
  * - White pieces are uppercase (P, N, B, R, Q, K)
  * - Black pieces are lowercase (p, n, b, r, q, k)
  * - NO_PIECE represents an empty square
+ *
+ * A piece is a single Type byte: white kinds take values 0-5 and black kinds 6-11, so that the type doubles as
+ * a dense index into 12-entry piece tables (bitboards, Zobrist keys). Color, kind and symbol are read from
+ * constexpr tables indexed by that byte, and characters are mapped back through a 256-entry table.
+ *
+ * Only the char constructor validates its input (and throws): it is meant for I/O boundaries such as tests or
+ * user input. Internal code builds pieces from types with Piece(Type) or make(), which never check nor throw.
  */
 class Piece {
  public:
-  /** @brief Enum for piece types */
-  enum Type : int { P, N, B, R, Q, K, p, n, b, r, q, k, NO_PIECE };
+  /** @brief Enum for piece types, stored on one byte so that it fits in compact tables (e.g. mailboxes) */
+  enum Type : uint8_t { P, N, B, R, Q, K, p, n, b, r, q, k, NO_PIECE };
+
+  /** @brief Enum for piece colors */
+  enum Color : uint8_t { WHITE, BLACK };
 
  private:
   Type m_type;
-  char m_symbol;
+
+  /** @brief Marks characters that are neither a piece nor '.' in FROM_CHAR. */
+  static constexpr uint8_t INVALID_CHAR = 0xFF;
+
+  /** @brief Symbol of each type, '.' for NO_PIECE. */
+  static constexpr char SYMBOLS[] = "PNBRQKpnbrqk.";
+
+  /** @brief Color of each type (WHITE for NO_PIECE, meaningless). */
+  static constexpr Color COLORS[] = {WHITE, WHITE, WHITE, WHITE, WHITE, WHITE,
+                                     BLACK, BLACK, BLACK, BLACK, BLACK, BLACK, WHITE};
+
+  /** @brief White type of the same kind as each type (NO_PIECE for NO_PIECE). */
+  static constexpr Type KINDS[] = {P, N, B, R, Q, K, P, N, B, R, Q, K, NO_PIECE};
+
+  /** @brief Type of each character, INVALID_CHAR for characters that are neither a piece nor '.'. */
+  static constexpr auto FROM_CHAR = []() constexpr {
+    std::array<uint8_t, 256> table{};
+    table.fill(INVALID_CHAR);
+    for (int type = P; type <= NO_PIECE; ++type) table[static_cast<unsigned char>(SYMBOLS[type])] = type;
+    return table;
+  }();
 
  public:
   /**
-   * @brief Constructs a piece.
-   * @param c Type of the piece to build
+   * @brief Constructs an empty piece (NO_PIECE).
+   */
+  constexpr Piece() : m_type(NO_PIECE) {}
+
+  /**
+   * @brief Constructs a piece from its character, for I/O boundaries.
+   * @param c Symbol of the piece ('P', 'n', ...) or '.' for NO_PIECE
    * @throw std::invalid_argument when the Piece character is invalid
    */
-  constexpr Piece(char c = '.') {
-    m_symbol = c;
-    switch (c) {  // clang-format off
-      case 'P': m_type = P; break;
-      case 'N': m_type = N; break;
-      case 'B': m_type = B; break;
-      case 'R': m_type = R; break;
-      case 'Q': m_type = Q; break;
-      case 'K': m_type = K; break;
-      case 'p': m_type = p; break;
-      case 'n': m_type = n; break;
-      case 'b': m_type = b; break;
-      case 'r': m_type = r; break;
-      case 'q': m_type = q; break;
-      case 'k': m_type = k; break;
-      case '.': m_type = NO_PIECE; break;  // clang-format on
-      default:
-        const std::string msg = fmt::format("Invalid piece character {}", c);
-        throw std::invalid_argument(msg);
+  constexpr Piece(char c) : m_type(NO_PIECE) {
+    const uint8_t type = FROM_CHAR[static_cast<unsigned char>(c)];
+    if (type == INVALID_CHAR) {
+      const std::string msg = fmt::format("Invalid piece character {}", c);
+      throw std::invalid_argument(msg);
     }
+    m_type = static_cast<Type>(type);
+  }
+
+  /**
+   * @brief Constructs a piece from its type, without any check.
+   * @param t Type of the piece to build
+   */
+  constexpr explicit Piece(Type t) : m_type(t) {}
+
+  /**
+   * @brief Looks up the piece of a character without throwing.
+   * @param c Symbol of the piece ('P', 'n', ...) or '.' for NO_PIECE
+   * @return The piece, or nullopt if `c` is neither a piece symbol nor '.'
+   */
+  static constexpr std::optional<Piece> from_char(char c) {
+    const uint8_t type = FROM_CHAR[static_cast<unsigned char>(c)];
+    if (type == INVALID_CHAR) return std::nullopt;
+    return Piece(static_cast<Type>(type));
+  }
+
+  /**
+   * @brief Returns the piece type of a given kind and color.
+   * @param color Color of the piece.
+   * @param kind Kind of the piece, given as its white type (P, N, B, R, Q or K).
+   * @return `kind` for WHITE, the matching lowercase type for BLACK.
+   */
+  static constexpr Type make_type(Color color, Type kind) {
+    return static_cast<Type>(kind + (color == BLACK ? p : P));
   }
 
+  /**
+   * @brief Returns the piece of a given kind and color, without any check.
+   * @param color Color of the piece.
+   * @param kind Kind of the piece, given as its white type (P, N, B, R, Q or K).
+   */
+  static constexpr Piece make(Color color, Type kind) { return Piece(make_type(color, kind)); }
+
   /**
    * @brief Returns the underlying enum type of the piece.
    * @return Type of the piece
    */
   constexpr Type type() const { return m_type; }
 
+  /**
+   * @brief Returns the kind of the piece regardless of its color.
+   * @return The white type of the same kind (P, N, B, R, Q or K), NO_PIECE for NO_PIECE
+   */
+  constexpr Type kind() const { return KINDS[m_type]; }
+
   /**
    * @brief Checks if the piece is white.
    * @return true if the piece is white, false otherwise
    */
-  constexpr bool is_white() const { return m_type >= P && m_type <= K; }
+  constexpr bool is_white() const { return m_type <= K; }
 
   /**
    * @brief Checks if the piece is black.
@@ -70,6 +136,12 @@ class Piece {
    */
   constexpr bool is_black() const { return m_type >= p && m_type <= k; }
 
+  /**
+   * @brief Returns the color of the piece.
+   * @return WHITE or BLACK, meaningless for NO_PIECE
+   */
+  constexpr Color color() const { return COLORS[m_type]; }
+
   /**
    * @brief Checks if the piece represents no piece.
    * @return true if NO_PIECE, false otherwise
@@ -80,8 +152,10 @@ class Piece {
    * @brief Converts the piece to a printable character.
    * @return 'P','N',...,'k' for pieces, '.' for NO_PIECE
    */
-  constexpr char to_char() const { return m_symbol; };
+  constexpr char to_char() const { return SYMBOLS[m_type]; };
 
   constexpr bool operator==(const Piece& other) const { return m_type == other.m_type; }
   constexpr bool operator!=(const Piece& other) const { return m_type != other.m_type; }
-};
\ No newline at end of file
+};
+
+static_assert(sizeof(Piece) == 1);
@@ -0,0 +1,152 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chess_engine/board.hpp>
+#include <chess_engine/move.hpp>
+#include <chess_engine/transposition_table.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+/**
+ * @namespace Search
+ * @brief Best move search: iterative deepening negamax with alpha-beta pruning.
+ *
+ * Each iteration searches the root one ply deeper than the previous one, with a quiescence search
+ * (captures and queen promotions only, or all evasions in check) at the horizon. The principal variation of
+ * the last completed iteration is searched first by the next one, or else the transposition table move; the
+ * other moves follow the MoveOrdering bands: winning captures, killer moves, counter move, quiet moves by
+ * history, losing captures. A MovePicker generates them in that order, stage by stage, so that a node cut
+ * off early never generates its quiet moves.
+ *
+ * With a transposition table, each node stores its score, bound and best move, and a node whose position
+ * is already stored with enough depth returns the stored score instead of searching (except at the root).
+ *
+ * Draws by repetition and by the fifty-move rule are detected along the searched path, including the
+ * game history leading to the root.
+ *
+ * Several threads search with Lazy SMP: all threads run iterative deepening on the same root, helpers skipping
+ * some depths so that they run ahead of the main thread, and they only cooperate through the shared
+ * transposition table. Each thread keeps its own board, node counter, PV table and History tables. The first
+ * thread to reach a limit stops them all; the main thread reports progress, and the result comes from the
+ * deepest completed iteration of any thread.
+ *
+ * @see https://www.chessprogramming.org/Iterative_Deepening
+ * @see https://www.chessprogramming.org/Alpha-Beta
+ * @see https://www.chessprogramming.org/Lazy_SMP
+ */
+namespace Search {
+
+/** @brief Maximum search depth in plies, quiescence search included. */
+constexpr int MAX_PLY = 128;
+
+/** @brief Score of being mated at the root; being mated in n plies scores -(VALUE_MATE - n). */
+constexpr int VALUE_MATE = 32000;
+
+/** @brief Bound above any score. */
+constexpr int VALUE_INFINITE = 32001;
+
+/** @brief Largest number of search threads. */
+constexpr unsigned MAX_THREADS = 256;
+
+/** @brief Checks if a score announces a mate, for either side. */
+constexpr bool is_mate_score(int score) { return score >= VALUE_MATE - MAX_PLY || score <= -(VALUE_MATE - MAX_PLY); }
+
+/**
+ * @brief Stop conditions of a search; zero means no limit. The search stops at the first one reached.
+ *
+ * Depth 1 is always completed by the main thread, so that a move is returned however tight the node or time
+ * budget. The node limit counts the nodes of all threads.
+ */
+struct Limits {
+  int depth = 0;                            ///< Maximum iteration depth, capped to MAX_PLY
+  uint64_t nodes = 0;                       ///< Maximum number of nodes
+  std::chrono::milliseconds movetime{0};    ///< Maximum wall-clock time
+  const std::atomic<bool>* stop = nullptr;  ///< Set by another thread to end the search, e.g. on a UCI "stop"
+};
+
+/**
+ * @brief Move ordering statistics: where the move causing each beta cutoff stood among the moves searched.
+ *
+ * Only interior nodes are counted, quiescence nodes excluded. With perfect ordering every cutoff comes from
+ * the first move; a well-ordered search reaches about 90% of first-move cutoffs.
+ */
+struct Stats {
+  uint64_t cutoffs = 0;             ///< Beta cutoffs
+  uint64_t first_move_cutoffs = 0;  ///< Beta cutoffs by the first move searched
+  uint64_t cutoff_index_sum = 0;    ///< Sum over the cutoffs of the 0-based index of the cutoff move
+
+  /** @brief Returns the share of cutoffs caused by the first move, in [0, 1] (0 without cutoffs). */
+  double first_move_cutoff_rate() const {
+    return cutoffs == 0 ? 0.0 : static_cast<double>(first_move_cutoffs) / static_cast<double>(cutoffs);
+  }
+
+  /** @brief Returns the average 0-based index of the cutoff move (0 without cutoffs). */
+  double average_cutoff_index() const {
+    return cutoffs == 0 ? 0.0 : static_cast<double>(cutoff_index_sum) / static_cast<double>(cutoffs);
+  }
+
+  Stats& operator+=(const Stats& other) {
+    cutoffs += other.cutoffs;
+    first_move_cutoffs += other.first_move_cutoffs;
+    cutoff_index_sum += other.cutoff_index_sum;
+    return *this;
+  }
+};
+
+/**
+ * @brief Progress report sent after each iteration completed by the main thread, and once more at the end if
+ * a helper thread completed a deeper one.
+ */
+struct Info {
+  int depth;                       ///< Completed iteration depth
+  int score;                       ///< Score for the side to move, in centipawns or mate score
+  uint64_t nodes;                  ///< Nodes searched by all threads since the start of the search
+  std::chrono::milliseconds time;  ///< Time elapsed since the start of the search
+  std::vector<Move> pv;            ///< Principal variation, starting with the best move
+  int hashfull = 0;                ///< Permill of the transposition table used by this search
+  Stats stats{};                   ///< Move ordering statistics of the main thread since the start of the search
+
+  /** @brief Returns the search speed of all threads together, in nodes per second. */
+  uint64_t nps() const { return nodes * 1000 / static_cast<uint64_t>(std::max<int64_t>(time.count(), 1)); }
+};
+
+/**
+ * @brief Outcome of a search: the deepest completed iteration.
+ */
+struct Result {
+  Move best_move;        ///< Null if the side to move has no legal move
+  int score = 0;         ///< Score for the side to move
+  int depth = 0;         ///< Depth of the last completed iteration
+  uint64_t nodes = 0;    ///< Nodes searched by all threads, including interrupted iterations
+  std::vector<Move> pv;  ///< Principal variation, starting with best_move
+  Stats stats{};         ///< Move ordering statistics of all threads
+};
+
+/**
+ * @brief Static evaluation of a position from the side to move's point of view, in centipawns.
+ *
+ * Material (See::PIECE_VALUES) plus a small bonus for centralized knights, bishops and pawns: enough for
+ * the search to play sensible moves, not meant as a strong evaluation.
+ */
+int evaluate(const Board& board);
+
+/**
+ * @brief Searches a position for the best move.
+ * @param board Position to search.
+ * @param limits Stop conditions.
+ * @param on_info Called after each completed iteration, may be empty.
+ * @param history Zobrist keys of the positions played before `board`, oldest first, for repetition detection.
+ * @param table Transposition table to probe and fill, aged by one search; nullptr to search without one.
+ * @param threads Number of search threads, clamped to [1, MAX_THREADS]. Helper threads only pay off with a
+ * table, through which they share their results.
+ * @return Best move, score and principal variation of the deepest completed iteration.
+ *
+ * `on_info` is called from the calling thread, which runs the main search thread.
+ */
+Result search(const Board& board, const Limits& limits, const std::function<void(const Info&)>& on_info = {},
+              std::span<const uint64_t> history = {}, TranspositionTable* table = nullptr, unsigned threads = 1);
+
+}  // namespace Search
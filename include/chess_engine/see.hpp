@@ -0,0 +1,53 @@
+#pragma once
+#include <array>
+#include <chess_engine/board.hpp>
+#include <chess_engine/move.hpp>
+#include <chess_engine/piece.hpp>
+
+/**
+ * @namespace See
+ * @brief Static Exchange Evaluation: material outcome of the capture sequence on one square, without searching.
+ *
+ * Both sides alternately recapture on the destination square with their least valuable attacker, each side
+ * being free to stop when continuing would lose material. Sliders hidden behind a piece that has just captured
+ * (x-rays, e.g. a queen behind a rook or a bishop behind a pawn) join the exchange as soon as they are uncovered:
+ * attackers are recomputed with Board::attackers_to() and occupancy-aware slider lookups after each capture.
+ *
+ * Pins and checks are ignored, as are promotions during the recaptures. A king only recaptures if the square
+ * is no longer defended.
+ */
+namespace See {
+
+/**
+ * @brief Exchange value of each piece kind in centipawns, indexed by the white type (P, N, B, R, Q, K).
+ *
+ * The king is worth more than all other pieces together, so that capturing it ends any exchange.
+ */
+constexpr std::array<int, 6> PIECE_VALUES = {100, 320, 330, 500, 900, 20000};
+
+/**
+ * @brief Returns the exchange value of a piece type of either color, 0 for NO_PIECE.
+ */
+constexpr int value(Piece::Type type) { return type == Piece::NO_PIECE ? 0 : PIECE_VALUES[Piece(type).kind()]; }
+
+/**
+ * @brief Evaluates the exchange started by a move.
+ * @param board Position before the move.
+ * @param move Move of the side to move, pseudo-legal in `board` (quiet moves are evaluated as well).
+ * @return Material balance of the exchange for the side to move, in centipawns. 0 for castling.
+ */
+int see(const Board& board, Move move);
+
+/**
+ * @brief Checks if the exchange started by a move wins at least a given amount.
+ * @param board Position before the move.
+ * @param move Move of the side to move, pseudo-legal in `board`.
+ * @param threshold Material balance to reach, in centipawns.
+ * @return see(board, move) >= threshold.
+ *
+ * Faster than see(): the exchange stops as soon as the outcome relative to the threshold is known, e.g. right
+ * away for a capture of a more valuable piece when the threshold is 0. Meant for move ordering and pruning.
+ */
+bool see_ge(const Board& board, Move move, int threshold);
+
+}  // namespace See
@@ -59,6 +59,19 @@ class Square {
    */
   constexpr explicit Square(Value v) : m_value(v) {}
 
+  /**
+   * @brief Builds a Square from a flattened index without any check, for internal hot loops.
+   * @param index Integer in range [0, 63], the caller guarantees it.
+   */
+  static constexpr Square unchecked(int index) { return Square(static_cast<Value>(index)); }
+
+  /**
+   * @brief Builds a Square from file and rank coordinates without any check, for internal hot loops.
+   * @param file File index in range [0, 7], the caller guarantees it.
+   * @param rank Rank index in range [0, 7], the caller guarantees it.
+   */
+  static constexpr Square unchecked(int file, int rank) { return Square(static_cast<Value>(rank * 8 + file)); }
+
   /**
    * @brief Construct a Square from file and rank coordinates.
    * @param file File index (0 = 'a', …, 7 = 'h').
@@ -0,0 +1,225 @@
+#pragma once
+#include <atomic>
+#include <chess_engine/move.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#include <xmmintrin.h>
+#endif
+
+/**
+ * @class TranspositionTable
+ * @brief Lock-free cache of search results keyed by Zobrist key, meant to be shared by all search threads.
+ *
+ * The table is an array of 64-byte clusters, one cache line each, holding four 16-byte entries. A key maps to
+ * one cluster and may be stored in any of its entries, so a probe touches a single cache line.
+ *
+ * Each entry is two 64-bit words written independently with relaxed atomics:
+ * - data: best move (16 bits), score (16), depth (8), bound (2) and age (6), the upper 16 bits unused;
+ * - check: Zobrist key XOR data.
+ *
+ * As in PerftHashTable, a probe only accepts an entry if check XOR data gives back the probed key, so an entry
+ * torn by two threads writing concurrently is rejected instead of returning another position's data.
+ *
+ * Replacement: an entry already holding the key is overwritten, unless it comes from the current search and is
+ * much deeper than a non-exact result. Otherwise the entry with the lowest depth, aged by the number of
+ * searches since it was written, is evicted.
+ *
+ * The clusters live either in private memory or, on POSIX systems, in a named shared-memory segment that
+ * several engine processes map at once (attach_shared()). The atomics are lock-free, hence address-free, so
+ * the XOR validation protects concurrent writes from other processes just like those from other threads.
+ * A shared segment starts with a SharedHeader holding the search generation, so that all processes age and
+ * count entries against the same generation.
+ */
+class TranspositionTable {
+ public:
+  /** @brief Kind of score stored: exact, or a bound from a beta cutoff (LOWER) or a fail low (UPPER). */
+  enum Bound : uint8_t { NONE = 0, UPPER = 1, LOWER = 2, EXACT = 3 };
+
+  /** @brief Decoded content of an entry. */
+  struct Data {
+    Move move;    ///< Best move, null if none (fail low)
+    int score;    ///< Score, relative to the node (see Search for mate score adjustment)
+    int depth;    ///< Remaining depth of the search that produced the score
+    Bound bound;  ///< How the score relates to the true value
+  };
+
+  /** @brief Default size in megabytes. */
+  static constexpr std::size_t DEFAULT_MB = 16;
+
+  /** @brief Largest accepted size in megabytes. */
+  static constexpr std::size_t MAX_MB = 65536;
+
+ private:
+  struct Entry {
+    std::atomic<uint64_t> check{0};
+    std::atomic<uint64_t> data{0};
+  };
+
+  static constexpr int CLUSTER_SIZE = 4;
+
+  struct alignas(64) Cluster {
+    Entry entries[CLUSTER_SIZE];
+  };
+  static_assert(sizeof(Cluster) == 64);
+
+  /** Ages are counted modulo 64 (6 bits). */
+  static constexpr uint8_t AGE_MASK = 63;
+
+  /**
+   * First cache line of a shared segment, followed by the clusters. The creator sets `initialized` to
+   * SHARED_MAGIC once the segment is sized and its entries are constructed; other processes wait for it before
+   * touching the clusters.
+   */
+  struct alignas(64) SharedHeader {
+    std::atomic<uint32_t> initialized{0};
+    std::atomic<uint8_t> generation{0};
+  };
+  static_assert(sizeof(SharedHeader) == sizeof(Cluster));
+
+  /** "TT" and the layout version, so that a segment with another layout is never taken for a valid one. */
+  static constexpr uint32_t SHARED_MAGIC = 0x54540001;
+
+  static_assert(std::atomic<uint64_t>::is_always_lock_free, "entries must be usable in shared memory");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint8_t>::is_always_lock_free,
+                "the shared header must be usable in shared memory");
+
+  Cluster* m_clusters = nullptr;
+  std::size_t m_cluster_count = 0;
+
+  /** Generation of a private table; a shared one uses the generation of its SharedHeader. */
+  std::atomic<uint8_t> m_private_generation{0};
+  std::atomic<uint8_t>* m_generation = &m_private_generation;
+
+  /** Name of the shared-memory segment the clusters are mapped from, empty for a private table. */
+  std::string m_shared_name;
+  SharedHeader* m_header = nullptr;  ///< Start of the mapping of a shared table
+  std::size_t m_mapped_bytes = 0;
+
+  /** Age of the entries written by the current search. */
+  uint8_t age() const { return m_generation->load(std::memory_order_relaxed) & AGE_MASK; }
+
+  /** Frees a private table or unmaps a shared one. */
+  void release();
+
+  static constexpr uint64_t pack(Move move, int score, int depth, Bound bound, uint8_t age) {
+    return static_cast<uint64_t>(move.raw()) | static_cast<uint64_t>(static_cast<uint16_t>(score)) << 16 |
+           static_cast<uint64_t>(depth & 0xFF) << 32 | static_cast<uint64_t>(bound) << 40 |
+           static_cast<uint64_t>(age) << 42;
+  }
+
+  static Move move_of(uint64_t data) { return Move::from_raw(static_cast<uint16_t>(data)); }
+  static int score_of(uint64_t data) { return static_cast<int16_t>(data >> 16); }
+  static int depth_of(uint64_t data) { return static_cast<int>((data >> 32) & 0xFF); }
+  static Bound bound_of(uint64_t data) { return static_cast<Bound>((data >> 40) & 3); }
+  static uint8_t age_of(uint64_t data) { return static_cast<uint8_t>((data >> 42) & AGE_MASK); }
+
+  /** @brief Cluster of a key: the high bits of key * cluster count, which spreads keys over any table size. */
+  Cluster& cluster(uint64_t key) const {
+#if defined(_MSC_VER) && defined(_M_X64)
+    return m_clusters[static_cast<std::size_t>(__umulh(key, m_cluster_count))];
+#else
+    return m_clusters[static_cast<std::size_t>((static_cast<unsigned __int128>(key) * m_cluster_count) >> 64)];
+#endif
+  }
+
+ public:
+  /**
+   * @brief Allocates a cleared table.
+   * @param megabytes Memory budget, rounded down to a whole number of clusters (at least one).
+   * @throw std::bad_alloc if the memory cannot be allocated.
+   */
+  explicit TranspositionTable(std::size_t megabytes = DEFAULT_MB);
+
+  ~TranspositionTable();
+  TranspositionTable(const TranspositionTable&) = delete;
+  TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+  /**
+   * @brief Reallocates the table with a new size in private memory, discarding its content.
+   * @param megabytes Memory budget, clamped to [1, MAX_MB].
+   * @return Nothing on success; std::errc::not_enough_memory if the allocation fails, and the table is then left
+   * unchanged (the new table is allocated before the old one is released).
+   *
+   * A shared table is detached from its segment, which stays available to the other processes.
+   */
+  [[nodiscard]] std::expected<void, std::error_code> resize(std::size_t megabytes);
+
+  /**
+   * @brief Moves the table to a named POSIX shared-memory segment, creating it if needed.
+   * @param name Segment name, e.g. "/chess_engine_tt" (see shm_open()).
+   * @param megabytes Size given to the segment if this call creates it, clamped to [1, MAX_MB]; a segment
+   * created by another process keeps its size.
+   * @return Nothing on success; otherwise the system error, and the table is left unchanged.
+   *
+   * The first process creates, sizes and clears the segment; the following ones map it as is, so they all
+   * probe and fill the same entries. A process attaching while the creator is still setting the segment up waits
+   * for it (up to a second, then std::errc::resource_unavailable_try_again). The segment outlives the processes
+   * until remove_shared() is called. Not supported on non-POSIX systems (std::errc::not_supported).
+   */
+  std::expected<void, std::error_code> attach_shared(std::string_view name, std::size_t megabytes);
+
+  /**
+   * @brief Removes a shared-memory segment name; processes that mapped it keep their mapping until they detach.
+   * @return Nothing on success, the system error otherwise.
+   */
+  static std::expected<void, std::error_code> remove_shared(std::string_view name);
+
+  /** @brief Returns the name of the shared-memory segment holding the table, empty for a private table. */
+  const std::string& shared_name() const { return m_shared_name; }
+
+  /** @brief Returns the number of entries. */
+  std::size_t size() const { return m_cluster_count * CLUSTER_SIZE; }
+
+  /** @brief Empties the table and resets the age; a shared table is emptied for every process using it. */
+  void clear();
+
+  /**
+   * @brief Ages all entries by one search: they become preferred victims for replacement.
+   *
+   * The generation of a shared table is common to all processes: a search started by any of them ages the
+   * entries of all the others.
+   */
+  void new_search() { m_generation->fetch_add(1, std::memory_order_relaxed); }
+
+  /**
+   * @brief Looks up a position.
+   * @param key Zobrist key of the position.
+   * @param data Set to the entry content on a hit.
+   * @return True on a hit.
+   */
+  bool probe(uint64_t key, Data& data) const;
+
+  /**
+   * @brief Stores a search result.
+   * @param key Zobrist key of the position.
+   * @param move Best move, or the null move to keep the move already stored for this key.
+   * @param score Score, which must fit in 16 bits.
+   * @param depth Remaining depth, in [0, 255].
+   * @param bound Kind of score.
+   */
+  void store(uint64_t key, Move move, int score, int depth, Bound bound);
+
+  /**
+   * @brief Starts loading the cluster of a key into the cache.
+   *
+   * Meant to be called right after making a move, with the new key: the cache miss of the probe is then
+   * overlapped with the work done before probing (repetition check, move generation setup).
+   */
+  void prefetch(uint64_t key) const {
+#if defined(_MSC_VER) && defined(_M_X64)
+    _mm_prefetch(reinterpret_cast<const char*>(&cluster(key)), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(&cluster(key));
+#endif
+  }
+
+  /** @brief Returns the permill of entries written by the current search, sampled on the first clusters. */
+  int hashfull() const;
+};
@@ -0,0 +1,83 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+/**
+ * @namespace Zobrist
+ * @brief Random keys used to compute 64-bit position hashes.
+ *
+ * A position key is the XOR of:
+ * - one key per (piece type, square) pair for every piece on the board
+ * - SIDE_TO_MOVE if Black is to move
+ * - the key of the current castling rights mask (4 bits, see Board::CastlingRight)
+ * - the key of the en passant file, if an en passant square is set
+ *
+ * Since XOR is its own inverse, the key can be updated incrementally: adding or removing a piece, changing the side
+ * to move or the castling rights is a single XOR with the corresponding key.
+ *
+ * Keys are generated at compile time with a fixed-seed SplitMix64 generator, so they are identical across builds.
+ *
+ * @see https://www.chessprogramming.org/Zobrist_Hashing
+ */
+namespace Zobrist {
+
+/**
+ * @brief SplitMix64 pseudo-random generator step.
+ * @param state Generator state, advanced by the call.
+ * @return Next pseudo-random 64-bit value.
+ */
+constexpr uint64_t splitmix64(uint64_t& state) {
+  uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief Keys for every (piece type, square) pair, indexed by Piece::Type (NO_PIECE excluded) then square.
+ */
+constexpr std::array<std::array<uint64_t, 64>, 12> PIECE_SQUARE = []() constexpr {
+  std::array<std::array<uint64_t, 64>, 12> table{};
+  uint64_t state = 0x5A0B1D2C3E4F6071ULL;
+  for (auto& squares : table) {
+    for (auto& key : squares) {
+      key = splitmix64(state);
+    }
+  }
+  return table;
+}();
+
+/**
+ * @brief Keys for each of the 16 castling rights combinations, indexed by castling mask.
+ */
+constexpr std::array<uint64_t, 16> CASTLING = []() constexpr {
+  std::array<uint64_t, 16> table{};
+  uint64_t state = 0x0C4A5713B2E9F86DULL;
+  for (auto& key : table) {
+    key = splitmix64(state);
+  }
+  table[0] = 0ULL;  // No castling rights: no contribution
+  return table;
+}();
+
+/**
+ * @brief Keys for each en passant file, indexed by file (0 = 'a', 7 = 'h').
+ */
+constexpr std::array<uint64_t, 8> EN_PASSANT_FILE = []() constexpr {
+  std::array<uint64_t, 8> table{};
+  uint64_t state = 0x7F3E91D2A4C6B805ULL;
+  for (auto& key : table) {
+    key = splitmix64(state);
+  }
+  return table;
+}();
+
+/**
+ * @brief Key toggled when Black is to move.
+ */
+constexpr uint64_t SIDE_TO_MOVE = []() constexpr {
+  uint64_t state = 0x3D8A6F1E2B4C5079ULL;
+  return splitmix64(state);
+}();
+
+}  // namespace Zobrist
@@ -0,0 +1,143 @@
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chess_engine/board.hpp>
+#include <chess_engine/perft.hpp>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+void print_usage() {
+  fmt::print(
+      "Usage: Perft [options] <depth> [fen]\n"
+      "  depth         number of plies to enumerate (at least 1)\n"
+      "  fen           position to start from, the starting position by default\n"
+      "                (may be quoted or passed as separate arguments)\n"
+      "Options:\n"
+      "  --threads N   worker threads, all hardware threads by default\n"
+      "  --hash MB     size of the shared node count cache in MB, 0 (default) to disable it\n"
+      "  --baseline    also time a single-threaded run without cache and report the speedup\n");
+}
+
+/**
+ * Parses a non-negative integer argument, returns -1 if invalid.
+ */
+long parse_count(std::string_view arg) {
+  try {
+    std::size_t end = 0;
+    const long value = std::stol(std::string(arg), &end);
+    return end == arg.size() && value >= 0 ? value : -1;
+  } catch (const std::exception&) {
+    return -1;
+  }
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t nodes_per_second(uint64_t nodes, double seconds) {
+  return seconds > 0.0 ? static_cast<uint64_t>(static_cast<double>(nodes) / seconds) : 0;
+}
+
+}  // namespace
+
+/**
+ * Counts the leaf nodes of the legal move tree of a position and prints, UCI-style:
+ * - the node count below each root move (divide), to compare against another engine when counts differ;
+ * - the total node count, elapsed time and nodes per second;
+ * - the hash hit rate (0% when the cache is disabled);
+ * - with --baseline only, the speedup over a single-threaded run without cache, which at high depths takes
+ *   far longer than the parallel run.
+ */
+int main(int argc, char* argv[]) {
+  unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  long hash_mb = 0;
+  bool baseline = false;
+
+  int arg = 1;
+  for (; arg < argc && std::string_view(argv[arg]).starts_with("--"); ++arg) {
+    const std::string_view option(argv[arg]);
+    if (option == "--baseline") {
+      baseline = true;
+      continue;
+    }
+    const long value = arg + 1 < argc ? parse_count(argv[arg + 1]) : -1;
+    if (option == "--threads" && value >= 1) {
+      threads = static_cast<unsigned>(value);
+    } else if (option == "--hash" && value >= 0) {
+      hash_mb = value;
+    } else {
+      print_usage();
+      return 1;
+    }
+    ++arg;
+  }
+
+  const long depth = arg < argc ? parse_count(argv[arg++]) : -1;
+  if (depth < 1) {
+    print_usage();
+    return 1;
+  }
+
+  std::string fen;
+  for (; arg < argc; ++arg) {
+    if (!fen.empty()) fen += ' ';
+    fen += argv[arg];
+  }
+  if (fen.empty()) fen = START_FEN;
+
+  Board board;
+  try {
+    board = Board(fen);
+  } catch (const std::exception& e) {
+    fmt::print(stderr, "Invalid FEN \"{}\": {}\n", fen, e.what());
+    return 1;
+  }
+
+  std::unique_ptr<PerftHashTable> table;
+  if (hash_mb > 0) table = std::make_unique<PerftHashTable>(static_cast<std::size_t>(hash_mb));
+
+  Perft::HashStats stats;
+  const auto start = std::chrono::steady_clock::now();
+  const std::vector<Perft::DivideEntry> entries =
+      Perft::divide(board, static_cast<int>(depth), threads, table.get(), &stats);
+  const double seconds = seconds_since(start);
+
+  uint64_t total = 0;
+  for (const Perft::DivideEntry& entry : entries) {
+    fmt::print("{}: {}\n", entry.move.to_uci(), entry.nodes);
+    total += entry.nodes;
+  }
+
+  const double hit_rate =
+      stats.probes ? 100.0 * static_cast<double>(stats.hits) / static_cast<double>(stats.probes) : 0.0;
+  fmt::print("\nMoves: {}\nNodes: {}\nTime: {:.3f} s\nNPS: {}\nThreads: {}\n", entries.size(), total, seconds,
+             nodes_per_second(total, seconds), threads);
+  fmt::print("Hash: {} entries, {} probes, {} hits ({:.1f}%)\n", table ? table->size() : 0, stats.probes, stats.hits,
+             hit_rate);
+
+  if (baseline) {
+    // Reference run, after the parallel one so that the attack tables are already built and not timed
+    const auto baseline_start = std::chrono::steady_clock::now();
+    const uint64_t baseline_nodes = Perft::perft(board, static_cast<int>(depth));
+    const double baseline_seconds = seconds_since(baseline_start);
+    fmt::print("Baseline: {} nodes in {:.3f} s, {} NPS (1 thread, no hash)\nSpeedup: {:.2f}x\n", baseline_nodes,
+               baseline_seconds, nodes_per_second(baseline_nodes, baseline_seconds),
+               seconds > 0.0 ? baseline_seconds / seconds : 0.0);
+    if (baseline_nodes != total) {
+      fmt::print(stderr, "Node count mismatch with the baseline run\n");
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -1,6 +1,19 @@
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chess_engine/board.hpp>
+#include <chess_engine/movegen.hpp>
+#include <chess_engine/perft.hpp>
+#include <chess_engine/search.hpp>
+#include <chess_engine/transposition_table.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 using std::cin;
@@ -24,46 +37,271 @@ vector<string> split(const string &s) {
   return tokens;
 }
 
+// Moves assumed left until the next time control when the GUI does not send "movestogo"
+constexpr int DEFAULT_MOVES_TO_GO = 30;
+
+// Finds the legal move written in UCI notation, or the null move if there is none
+Move parse_move(const Board &board, const string &uci) {
+  MoveList moves;
+  MoveGen::generate_legal(board, moves);
+  for (const Move move : moves) {
+    if (move.to_uci() == uci) return move;
+  }
+  return Move();
+}
+
+// Handles "position startpos|fen <fen> [moves <move>...]". The keys of the positions before the last
+// move are kept in history, for repetition detection. An invalid FEN leaves the position unchanged,
+// an illegal move ends the move list.
+void set_position(Board &board, vector<uint64_t> &history, const vector<string> &tokens) {
+  std::size_t index = 1;
+  if (index < tokens.size() && tokens[index] == "startpos") {
+    board = Board();
+    ++index;
+  } else if (index < tokens.size() && tokens[index] == "fen") {
+    string fen;
+    for (++index; index < tokens.size() && tokens[index] != "moves"; ++index) {
+      fen += (fen.empty() ? "" : " ") + tokens[index];
+    }
+    const auto parsed = Board::from_fen(fen);
+    if (!parsed) return;
+    board = *parsed;
+  } else {
+    return;
+  }
+  history.clear();
+
+  if (index < tokens.size() && tokens[index] == "moves") {
+    for (++index; index < tokens.size(); ++index) {
+      const Move move = parse_move(board, tokens[index]);
+      if (move.is_null()) break;
+      history.push_back(board.hash());
+      board.make_move(move);
+    }
+  }
+}
+
+// Formats a score as "cp <centipawns>" or "mate <moves>", negative when the engine is getting mated
+string format_score(int score) {
+  if (!Search::is_mate_score(score)) return "cp " + std::to_string(score);
+  const int moves = score > 0 ? (Search::VALUE_MATE - score + 1) / 2 : -(Search::VALUE_MATE + score) / 2;
+  return "mate " + std::to_string(moves);
+}
+
+// Formats a number with a fixed count of decimals
+string format_fixed(double value, int decimals) {
+  char buffer[32];
+  const auto end = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, decimals).ptr;
+  return string(buffer, end);
+}
+
+// Parses the limits of "go [depth N] [nodes N] [movetime MS] [wtime MS btime MS winc MS binc MS movestogo N]
+// [infinite]"; without any, the search runs until "stop"
+Search::Limits parse_go(const Board &board, const vector<string> &tokens) {
+  Search::Limits limits;
+  int64_t time_left = 0;
+  int64_t increment = 0;
+  int moves_to_go = DEFAULT_MOVES_TO_GO;
+  const string our_time = board.is_white_turn() ? "wtime" : "btime";
+  const string our_increment = board.is_white_turn() ? "winc" : "binc";
+  for (std::size_t i = 1; i + 1 < tokens.size(); ++i) {
+    const string &value = tokens[i + 1];
+    if (tokens[i] == "depth") {
+      limits.depth = std::atoi(value.c_str());
+    } else if (tokens[i] == "nodes") {
+      limits.nodes = std::strtoull(value.c_str(), nullptr, 10);
+    } else if (tokens[i] == "movetime") {
+      limits.movetime = std::chrono::milliseconds(std::atoll(value.c_str()));
+    } else if (tokens[i] == our_time) {
+      time_left = std::atoll(value.c_str());
+    } else if (tokens[i] == our_increment) {
+      increment = std::atoll(value.c_str());
+    } else if (tokens[i] == "movestogo") {
+      moves_to_go = std::max(std::atoi(value.c_str()), 1);
+    }
+  }
+  // With a clock, spend an even share of the remaining time plus most of the increment, never more than half
+  if (time_left > 0 && limits.movetime.count() == 0) {
+    const int64_t budget = std::min(time_left / moves_to_go + increment * 3 / 4, time_left / 2);
+    limits.movetime = std::chrono::milliseconds(std::max<int64_t>(budget, 1));
+  }
+  return limits;
+}
+
+// Checks if a search ends by itself, at a depth, node or time limit
+bool is_bounded(const Search::Limits &limits) {
+  return limits.depth > 0 || limits.nodes != 0 || limits.movetime.count() != 0;
+}
+
+// Searches the position, prints one info line per completed iteration, the move ordering statistics as an
+// "info string", then the best move. With "go infinite", the best move waits for "stop" even if the search
+// ends first. Runs on the search thread: every line is written under output_mutex.
+void go_search(const Board &board, const vector<uint64_t> &history, TranspositionTable &table, unsigned threads,
+               const Search::Limits &limits, bool infinite, ostream &output, std::mutex &output_mutex) {
+  const auto print_info = [&output, &output_mutex](const Search::Info &info) {
+    std::lock_guard lock(output_mutex);
+    output << "info depth " << info.depth << " score " << format_score(info.score) << " nodes " << info.nodes
+           << " nps " << info.nps() << " hashfull " << info.hashfull << " time " << info.time.count() << " pv";
+    for (const Move move : info.pv) output << " " << move.to_uci();
+    output << endl;
+  };
+  const Search::Result result = Search::search(board, limits, print_info, history, &table, threads);
+  if (infinite) limits.stop->wait(false);
+
+  std::lock_guard lock(output_mutex);
+  if (!result.best_move.is_null()) {
+    output << "info string cutoffs " << result.stats.cutoffs << " firstmove "
+           << format_fixed(100.0 * result.stats.first_move_cutoff_rate(), 1) << "% avgindex "
+           << format_fixed(result.stats.average_cutoff_index(), 2) << endl;
+  }
+  output << "bestmove " << (result.best_move.is_null() ? "0000" : result.best_move.to_uci()) << endl;
+}
+
+// Engine settings changed through "setoption"
+struct Options {
+  std::size_t hash_mb = TranspositionTable::DEFAULT_MB;
+  unsigned threads = 1;
+};
+
+// Handles "setoption name <name> [value <value>]". Supported:
+// - Hash: table size in MB; the table is cleared, and moved back to private memory if it was shared; if the
+//   memory cannot be allocated, the previous table is kept and the error is reported in an "info string"
+// - Threads: number of search threads
+// - SharedHash: name of a POSIX shared-memory segment to keep the table in, shared with the other engine
+//   processes using the same name (created with the Hash size if none exists yet); <empty> for a private table
+void set_option(TranspositionTable &table, Options &options, const vector<string> &tokens, ostream &output) {
+  if (tokens.size() < 5 || tokens[1] != "name" || tokens[3] != "value") return;
+  if (tokens[2] == "SharedHash") {
+    if (tokens[4] == "<empty>") {
+      // Detaching needs a private table of the same size; if it cannot be allocated, the shared one is kept
+      if (!table.shared_name().empty()) {
+        if (const auto resized = table.resize(options.hash_mb); !resized) {
+          output << "info string SharedHash <empty>: " << resized.error().message() << endl;
+        }
+      }
+    } else if (const auto attached = table.attach_shared(tokens[4], options.hash_mb); !attached) {
+      output << "info string SharedHash " << tokens[4] << ": " << attached.error().message() << endl;
+    }
+    return;
+  }
+  const long long value = std::atoll(tokens[4].c_str());
+  if (value <= 0) return;
+  if (tokens[2] == "Hash") {
+    // On allocation failure the previous table and size are kept
+    if (const auto resized = table.resize(static_cast<std::size_t>(value)); !resized) {
+      output << "info string Hash " << value << ": " << resized.error().message() << endl;
+    } else {
+      options.hash_mb = static_cast<std::size_t>(value);
+    }
+  } else if (tokens[2] == "Threads") {
+    options.threads = static_cast<unsigned>(std::min<long long>(value, Search::MAX_THREADS));
+  }
+}
+
+// Search started by "go", running on its own thread so that the loop keeps reading "isready", "stop" and "quit"
+struct SearchThread {
+  std::thread worker;
+  std::atomic<bool> stop{false};
+  bool bounded = false;
+};
+
+// Ends the running search, if any, and waits for its best move. A bounded search is left to reach its limit
+// unless interrupt is set; an unbounded one is always stopped, since nothing else would end it.
+void end_search(SearchThread &search, bool interrupt) {
+  if (!search.worker.joinable()) return;
+  if (interrupt || !search.bounded) {
+    search.stop.store(true);
+    search.stop.notify_all();
+  }
+  search.worker.join();
+}
+
+// Handles "go perft <depth>": prints the node count below each root move, then the total
+void go_perft(Board &board, int depth, ostream &output) {
+  uint64_t total = 0;
+  for (const Perft::DivideEntry &entry : Perft::divide(board, depth)) {
+    output << entry.move.to_uci() << ": " << entry.nodes << endl;
+    total += entry.nodes;
+  }
+  output << endl << "Nodes searched: " << total << endl;
+}
+
 // Main UCI loop
 void uci_loop(istream &input = cin, ostream &output = cout) {
   string line;
   vector<string> tokens;
+  Board board;
+  vector<uint64_t> history;
+  TranspositionTable table;
+  Options options;
+  SearchThread search;
+  std::mutex output_mutex;
 
   while (getline(input, line)) {
     tokens = split(line);
 
     if (tokens.empty()) continue;
 
+    // A running search only lets these through; any other command waits for its best move
+    if (tokens[0] != "isready" && tokens[0] != "stop" && tokens[0] != "quit") end_search(search, false);
+
     if (tokens[0] == "uci") {
       // Identify the engine
       output << "id name ChessEngine" << endl;
       output << "id author Hardcode" << endl;
       // Send options available
+      output << "option name Hash type spin default " << TranspositionTable::DEFAULT_MB << " min 1 max "
+             << TranspositionTable::MAX_MB << endl;
+      output << "option name Threads type spin default 1 min 1 max " << Search::MAX_THREADS << endl;
+      output << "option name SharedHash type string default <empty>" << endl;
       output << "uciok" << endl;
     } else if (tokens[0] == "isready") {
-      // Engine is ready
+      // Engine is ready, even while searching
+      std::lock_guard lock(output_mutex);
       output << "readyok" << endl;
     } else if (tokens[0] == "ucinewgame") {
       // Reset the engine for a new game
-      // TODO: Implement new game initialization
+      board = Board();
+      history.clear();
+      // A shared table also serves the other processes, which may still be analysing
+      if (table.shared_name().empty()) table.clear();
+    } else if (tokens[0] == "setoption") {
+      // Configure the engine
+      set_option(table, options, tokens, output);
     } else if (tokens[0] == "position") {
-      // Handle position command
-      // TODO: Implement position parsing and setup
+      // Set up the position to search
+      set_position(board, history, tokens);
+    } else if (tokens[0] == "go" && tokens.size() >= 3 && tokens[1] == "perft") {
+      // Count leaf nodes of the current position, as a move generator check
+      const int depth = std::atoi(tokens[2].c_str());
+      if (depth > 0) go_perft(board, depth, output);
     } else if (tokens[0] == "go") {
-      // Start calculating
-      // TODO: Implement move calculation
-      output << "bestmove e2e4" << endl;  // Placeholder
+      // Search the current position in the background; the search thread reports the best move
+      Search::Limits limits = parse_go(board, tokens);
+      const bool infinite = std::find(tokens.begin(), tokens.end(), "infinite") != tokens.end();
+      limits.stop = &search.stop;
+      search.stop.store(false);
+      search.bounded = !infinite && is_bounded(limits);
+      search.worker = std::thread([&, board, history, limits, infinite] {
+        go_search(board, history, table, options.threads, limits, infinite, output, output_mutex);
+      });
     } else if (tokens[0] == "quit") {
-      // Exit the program
+      // Exit the program, interrupting the search
+      end_search(search, true);
       break;
     } else if (tokens[0] == "stop") {
-      // Stop calculating
-      // TODO: Implement stop calculation
+      // End the search now: the best move found so far is reported
+      end_search(search, true);
     }
   }
+  // At the end of the input, a bounded search still completes
+  end_search(search, false);
 }
 
+// Tests include this file and provide their own main
+#ifndef UCI_LOOP_NO_MAIN
 int main() {
   uci_loop();
   return 0;
 }
+#endif
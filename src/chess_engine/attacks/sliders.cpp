@@ -0,0 +1,114 @@
+#include <bit>
+#include <chess_engine/attacks/sliders.hpp>
+#include <chess_engine/cpu.hpp>
+#include <span>
+
+namespace {
+
+using namespace Attacks;
+
+/*
+ * Blocked rays are derived from the empty-board ray helpers:
+ * the ray behind the first blocker is the ray of the same direction starting from that blocker,
+ * so it just has to be removed from the full ray.
+ *
+ * Rays going towards higher square indices (north, east, north-east, north-west) hit their first blocker
+ * at the least significant set bit, the other ones at the most significant set bit.
+ */
+using RayFunction = uint64_t (*)(int);
+
+uint64_t positive_ray(RayFunction ray, int sq, uint64_t occupancy) {
+  const uint64_t attacks = ray(sq);
+  const uint64_t blockers = attacks & occupancy;
+  if (blockers == 0ULL) return attacks;
+  return attacks & ~ray(std::countr_zero(blockers));
+}
+
+uint64_t negative_ray(RayFunction ray, int sq, uint64_t occupancy) {
+  const uint64_t attacks = ray(sq);
+  const uint64_t blockers = attacks & occupancy;
+  if (blockers == 0ULL) return attacks;
+  return attacks & ~ray(63 - std::countl_zero(blockers));
+}
+
+uint64_t rook_attacks_on_the_fly(int sq, uint64_t occupancy) {
+  return positive_ray(rook_north_attacks, sq, occupancy) | positive_ray(rook_east_attacks, sq, occupancy) |
+         negative_ray(rook_south_attacks, sq, occupancy) | negative_ray(rook_west_attacks, sq, occupancy);
+}
+
+uint64_t bishop_attacks_on_the_fly(int sq, uint64_t occupancy) {
+  return positive_ray(bishop_northeast_attacks, sq, occupancy) |
+         positive_ray(bishop_northwest_attacks, sq, occupancy) |
+         negative_ray(bishop_southeast_attacks, sq, occupancy) | negative_ray(bishop_southwest_attacks, sq, occupancy);
+}
+
+/**
+ * Builds the entries and the attack table of one slider type for a backend.
+ *
+ * Every subset of a relevance mask is enumerated with the Carry-Rippler trick (`subset = (subset - mask) & mask`).
+ * With magics every square owns a block of 2^bits entries; with PEXT blocks are packed back to back.
+ * The table is taken as a span so a single function fills either slider's table.
+ */
+void build_slider_table(SliderBackend backend, std::array<SliderEntry, 64>& entries, std::span<Bitboard> table,
+                        const std::array<Bitboard, 64>& masks, const std::array<uint64_t, 64>& magics, int bits,
+                        uint64_t (*attacks_on_the_fly)(int, uint64_t)) {
+  std::size_t offset = 0;
+  for (int sq = 0; sq < 64; ++sq) {
+    const uint64_t mask = masks[sq].value();
+    const std::size_t block_size =
+        backend == SliderBackend::Pext ? std::size_t{1} << std::popcount(mask) : std::size_t{1} << bits;
+    const std::span<Bitboard> block = table.subspan(offset, block_size);
+    entries[sq] = SliderEntry{mask, magics[sq], block.data()};
+
+    uint64_t subset = 0ULL;
+    do {
+      block[slider_index(backend, entries[sq], subset, bits)] = Bitboard(attacks_on_the_fly(sq, subset));
+      subset = (subset - mask) & mask;
+    } while (subset != 0ULL);
+
+    offset += block_size;
+  }
+}
+
+}  // namespace
+
+namespace Attacks {
+
+detail::SliderTables::SliderTables() {
+  build(Cpu::has_fast_pext() && PEXT_COMPILED ? SliderBackend::Pext : SliderBackend::Magic);
+}
+
+void detail::SliderTables::build(SliderBackend selected) {
+  backend = selected;
+  build_slider_table(backend, rook, rook_attacks, ROOK_MASKS, ROOK_MAGICS, ROOK_INDEX_BITS, rook_attacks_on_the_fly);
+  build_slider_table(backend, bishop, bishop_attacks, BISHOP_MASKS, BISHOP_MAGICS, BISHOP_INDEX_BITS,
+                     bishop_attacks_on_the_fly);
+}
+
+const char* slider_backend_name(SliderBackend backend) {
+  switch (backend) {
+    case SliderBackend::Magic:
+      return "magic";
+    case SliderBackend::Pext:
+      return "pext";
+  }
+  return "unknown";
+}
+
+bool slider_backend_supported(SliderBackend backend) {
+  switch (backend) {
+    case SliderBackend::Magic:
+      return true;
+    case SliderBackend::Pext:
+      return PEXT_COMPILED && Cpu::has_bmi2();
+  }
+  return false;
+}
+
+bool select_slider_backend(SliderBackend backend) {
+  if (!slider_backend_supported(backend)) return false;
+  detail::slider_tables().build(backend);
+  return true;
+}
+
+}  // namespace Attacks
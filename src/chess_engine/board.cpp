@@ -1,175 +1,296 @@
 #include <fmt/core.h>
 
+#include <array>
+#include <cassert>
+#include <chess_engine/attacks/king.hpp>
+#include <chess_engine/attacks/knight.hpp>
+#include <chess_engine/attacks/pawn.hpp>
+#include <chess_engine/attacks/sliders.hpp>
 #include <chess_engine/board.hpp>
-#include <sstream>
+#include <chess_engine/zobrist.hpp>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * Castling rights lost when a move starts from or lands on a square:
+ * moving the king loses both rights of its side, moving or capturing a rook loses the right on its side.
+ */
+constexpr std::array<uint8_t, 64> CASTLING_RIGHTS_LOST = []() constexpr {
+  std::array<uint8_t, 64> table{};
+  table[Square::E1] = Board::WHITE_KINGSIDE | Board::WHITE_QUEENSIDE;
+  table[Square::H1] = Board::WHITE_KINGSIDE;
+  table[Square::A1] = Board::WHITE_QUEENSIDE;
+  table[Square::E8] = Board::BLACK_KINGSIDE | Board::BLACK_QUEENSIDE;
+  table[Square::H8] = Board::BLACK_KINGSIDE;
+  table[Square::A8] = Board::BLACK_QUEENSIDE;
+  return table;
+}();
+
+/**
+ * Rook origin and destination squares of a castling move, given the king destination square.
+ */
+constexpr Square castling_rook_from(Square king_to) {
+  return Square::unchecked(king_to.value() + (king_to.file() == 6 ? 1 : -2));
+}
+
+constexpr Square castling_rook_to(Square king_to) {
+  return Square::unchecked(king_to.value() + (king_to.file() == 6 ? -1 : 1));
+}
+
+/**
+ * Square of the pawn taken by an en passant capture: next to the origin square, on the destination file.
+ */
+constexpr Square en_passant_victim(Move move) {
+  return Square::unchecked(move.to().file(), move.from().rank());
+}
+
+}  // namespace
 
 Board::Board() : Board("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1") {}
 
-Board::Board(const std::string& fen) {
-  /*
-   * https://en.wikipedia.org/wiki/Forsyth%E2%80%93Edwards_Notation
-   * https://www.chess.com/terms/fen-chess
-   *
-   * FEN (Forsyth-Edwards Notation) has 6 fields separated by slashes and spaces:
-   *
-   * 1. Piece placement (ranks 8 → 1, separated by /).
-   * 2. Side to move (w or b).
-   * 3. Castling availability (KQkq or -).
-   * 4. En passant target square (like e3 or -).
-   * 5. Halfmove clock (for 50-move rule).
-   * 6. Fullmove number (starts at 1).
-   *
-   * Example FEN for starting position: "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
-   */
-  std::istringstream iss(fen);
-  std::string token;
-  iss >> token;
-
-  int index = 64 - 8;
-  for (auto c : token) {
-    if (c == '/') {
-      index -= 2 * 8;
-      continue;
-    } else if (isdigit(c)) {
-      const int skip = c - '0';
-      index += skip;
-      continue;
+Board::Board(EmptyTag)
+    : m_state{0, NO_EN_PASSANT, Piece::WHITE, 0, 0, 1}, m_hash(0ULL) {
+  m_mailbox.fill(Piece::NO_PIECE);
+}
+
+Board::Board(const std::string& fen) : Board(EmptyTag{}) {
+  const std::expected<Board, FenError> parsed = from_fen(fen);
+  if (!parsed) {
+    throw std::invalid_argument(fmt::format("Invalid FEN '{}': {} at offset {}", fen, parsed.error().message(),
+                                            parsed.error().offset));
+  }
+  *this = *parsed;
+}
+
+Piece Board::get_piece(Square sq) const { return Piece(m_mailbox[sq.value()]); }
+
+void Board::put_piece(Piece::Type type, Square sq) {
+  m_hash ^= Zobrist::PIECE_SQUARE[type][sq.value()];
+  m_pieces[type].set(sq);
+  m_colors[Piece(type).color()].set(sq);
+  m_occupied.set(sq);
+  m_mailbox[sq.value()] = type;
+}
+
+void Board::take_piece(Square sq) {
+  const Piece::Type type = m_mailbox[sq.value()];
+  m_hash ^= Zobrist::PIECE_SQUARE[type][sq.value()];
+  m_pieces[type].clear(sq);
+  m_colors[Piece(type).color()].clear(sq);
+  m_occupied.clear(sq);
+  m_mailbox[sq.value()] = Piece::NO_PIECE;
+}
+
+void Board::move_piece(Square from, Square to) {
+  const Piece::Type type = m_mailbox[from.value()];
+  take_piece(from);
+  put_piece(type, to);
+}
+
+void Board::set_piece(Square sq, Piece p) {
+  // Remove any existing piece if existent
+  remove_piece(sq);
+
+  if (!p.is_none()) {
+    put_piece(p.type(), sq);
+  }
+
+  assert(is_consistent());
+}
+
+void Board::remove_piece(Square sq) {
+  // The mailbox tells which bitboard holds the square (if any)
+  if (m_mailbox[sq.value()] != Piece::NO_PIECE) {
+    take_piece(sq);
+  }
+
+  assert(is_consistent());
+}
+
+bool Board::en_passant_capturable(Square skipped, Piece::Color capturer) const {
+  // A capturer attacks the skipped square from where a pawn of the pushing color on it would attack
+  const Bitboard attackers = capturer == Piece::BLACK
+                                 ? Attacks::WHITE_PAWN_ATTACKS[skipped.value()] & m_pieces[Piece::p]
+                                 : Attacks::BLACK_PAWN_ATTACKS[skipped.value()] & m_pieces[Piece::P];
+  return attackers != Bitboard();
+}
+
+Square Board::king_square(Piece::Color color) const {
+  return m_pieces[Piece::make_type(color, Piece::K)].lsb();
+}
+
+bool Board::is_square_attacked(Square sq, Piece::Color by) const {
+  using namespace Attacks;
+  const int s = sq.value();
+
+  // A pawn of `by` attacks `sq` if a pawn of the other color standing on `sq` would attack it
+  const Bitboard pawn_sources = by == Piece::WHITE ? BLACK_PAWN_ATTACKS[s] : WHITE_PAWN_ATTACKS[s];
+  if ((pawn_sources & m_pieces[Piece::make_type(by, Piece::P)]).value()) return true;
+  if ((KNIGHT_ATTACKS[s] & m_pieces[Piece::make_type(by, Piece::N)]).value()) return true;
+  if ((KING_ATTACKS[s] & m_pieces[Piece::make_type(by, Piece::K)]).value()) return true;
+
+  const Bitboard queens = m_pieces[Piece::make_type(by, Piece::Q)];
+  const Bitboard rooks = m_pieces[Piece::make_type(by, Piece::R)] | queens;
+  const Bitboard bishops = m_pieces[Piece::make_type(by, Piece::B)] | queens;
+  if ((rook_attacks(sq, m_occupied) & rooks).value()) return true;
+  return (bishop_attacks(sq, m_occupied) & bishops).value() != 0ULL;
+}
+
+Bitboard Board::attackers_to(Square sq, Bitboard occ) const {
+  using namespace Attacks;
+  const int s = sq.value();
+  const Bitboard rooks = m_pieces[Piece::R] | m_pieces[Piece::r] | m_pieces[Piece::Q] | m_pieces[Piece::q];
+  const Bitboard bishops = m_pieces[Piece::B] | m_pieces[Piece::b] | m_pieces[Piece::Q] | m_pieces[Piece::q];
+
+  // Pawns are found from the target square with the attacks of a pawn of the opposite color
+  return (BLACK_PAWN_ATTACKS[s] & m_pieces[Piece::P]) | (WHITE_PAWN_ATTACKS[s] & m_pieces[Piece::p]) |
+         (KNIGHT_ATTACKS[s] & (m_pieces[Piece::N] | m_pieces[Piece::n])) |
+         (KING_ATTACKS[s] & (m_pieces[Piece::K] | m_pieces[Piece::k])) | (rook_attacks(sq, occ) & rooks) |
+         (bishop_attacks(sq, occ) & bishops);
+}
+
+Bitboard Board::attacked_squares(Piece::Color by) const {
+  using namespace Attacks;
+  const Bitboard pawns = m_pieces[Piece::make_type(by, Piece::P)];
+  Bitboard attacks = by == Piece::WHITE ? pawns.shift<NORTH_EAST>() | pawns.shift<NORTH_WEST>()
+                                        : pawns.shift<SOUTH_EAST>() | pawns.shift<SOUTH_WEST>();
+  for (const Square sq : m_pieces[Piece::make_type(by, Piece::N)]) attacks |= KNIGHT_ATTACKS[sq.value()];
+  for (const Square sq : m_pieces[Piece::make_type(by, Piece::K)]) attacks |= KING_ATTACKS[sq.value()];
+
+  const Bitboard queens = m_pieces[Piece::make_type(by, Piece::Q)];
+  for (const Square sq : m_pieces[Piece::make_type(by, Piece::B)] | queens) attacks |= bishop_attacks(sq, m_occupied);
+  for (const Square sq : m_pieces[Piece::make_type(by, Piece::R)] | queens) attacks |= rook_attacks(sq, m_occupied);
+
+  return attacks;
+}
+
+bool Board::in_check() const {
+  return is_square_attacked(king_square(side_to_move()), is_white_turn() ? Piece::BLACK : Piece::WHITE);
+}
+
+Board::UndoInfo Board::make_move(Move move) {
+  UndoInfo undo{m_hash, m_state, Piece::NO_PIECE};
+
+  const Square from = move.from();
+  const Square to = move.to();
+  const Piece::Color us = side_to_move();
+  const Piece::Type pawn = us == Piece::WHITE ? Piece::P : Piece::p;
+  const Piece::Type moving = m_mailbox[from.value()];
+
+  set_en_passant_square(std::nullopt);
+  ++m_state.halfmove_clock;
+
+  if (move.type() == Move::CASTLING) {
+    move_piece(from, to);
+    move_piece(castling_rook_from(to), castling_rook_to(to));
+  } else {
+    const Square captured_sq = move.type() == Move::EN_PASSANT ? en_passant_victim(move) : to;
+    undo.captured = m_mailbox[captured_sq.value()];
+    if (undo.captured != Piece::NO_PIECE) {
+      take_piece(captured_sq);
+      m_state.halfmove_clock = 0;
+    }
+
+    if (move.type() == Move::PROMOTION) {
+      take_piece(from);
+      put_piece(move.promotion_type(us), to);
     } else {
-      const Square square(index);
-      Piece piece(c);
-      set_piece(square, piece);
-      index++;
+      move_piece(from, to);
+    }
+
+    if (moving == pawn) {
+      m_state.halfmove_clock = 0;
+
+      // Double push: the skipped square becomes the en passant target if an enemy pawn attacks it
+      if (to.value() - from.value() == 16 || from.value() - to.value() == 16) {
+        const Square skipped = Square::unchecked((from.value() + to.value()) / 2);
+        if (en_passant_capturable(skipped, us == Piece::WHITE ? Piece::BLACK : Piece::WHITE)) {
+          set_en_passant_square(skipped);
+        }
+      }
     }
   }
 
-  // Second token: side to move
-  iss >> token;
-  m_is_white_turn = (token == "w") ? true : false;
-
-  // Third token: Castling Rights
-  iss >> token;
-  m_white_castle_kingside = token.find('K') != std::string::npos;
-  m_white_castle_queenside = token.find('Q') != std::string::npos;
-  m_black_castle_kingside = token.find('k') != std::string::npos;
-  m_black_castle_queenside = token.find('q') != std::string::npos;
-
-  // Fourth token: en passant
-  iss >> token;
-  if (token == "-") {
-    m_en_passant_sq = std::nullopt;
+  const uint8_t lost = CASTLING_RIGHTS_LOST[from.value()] | CASTLING_RIGHTS_LOST[to.value()];
+  if (undo.state.castling_rights & lost) set_castling_rights(undo.state.castling_rights & ~lost);
+
+  if (us == Piece::BLACK) ++m_state.fullmove_number;
+  m_state.side_to_move ^= 1;
+  m_hash ^= Zobrist::SIDE_TO_MOVE;
+
+  return undo;
+}
+
+void Board::unmake_move(Move move, const UndoInfo& undo) {
+  const Piece::Color us = static_cast<Piece::Color>(undo.state.side_to_move);
+
+  const Square from = move.from();
+  const Square to = move.to();
+
+  if (move.type() == Move::CASTLING) {
+    move_piece(to, from);
+    move_piece(castling_rook_to(to), castling_rook_from(to));
   } else {
-    m_en_passant_sq = Square(token);
+    if (move.type() == Move::PROMOTION) {
+      take_piece(to);
+      put_piece(us == Piece::WHITE ? Piece::P : Piece::p, from);
+    } else {
+      move_piece(to, from);
+    }
+
+    if (undo.captured != Piece::NO_PIECE) {
+      put_piece(undo.captured, move.type() == Move::EN_PASSANT ? en_passant_victim(move) : to);
+    }
   }
 
-  // Fifth token: Halfmove clock
-  iss >> m_halfmove_clock;
-
-  // Sixth token: Fullmove number
-  iss >> m_fullmove_number;
-}
-
-Bitboard Board::white_pieces() const {
-  Bitboard bb;
-  bb |= m_w_pawns;
-  bb |= m_w_rooks;
-  bb |= m_w_bishops;
-  bb |= m_w_knights;
-  bb |= m_w_king;
-  bb |= m_w_queen;
-  return bb;
-}
-
-Bitboard Board::black_pieces() const {
-  Bitboard bb;
-  bb |= m_b_pawns;
-  bb |= m_b_rooks;
-  bb |= m_b_bishops;
-  bb |= m_b_knights;
-  bb |= m_b_king;
-  bb |= m_b_queen;
-  return bb;
-}
-
-Bitboard Board::occupied() const {
-  Bitboard bb;
-  bb |= m_b_pawns;
-  bb |= m_b_rooks;
-  bb |= m_b_bishops;
-  bb |= m_b_knights;
-  bb |= m_b_king;
-  bb |= m_b_queen;
-  bb |= m_w_pawns;
-  bb |= m_w_rooks;
-  bb |= m_w_bishops;
-  bb |= m_w_knights;
-  bb |= m_w_king;
-  bb |= m_w_queen;
-  return bb;
-}
-
-Piece Board::get_piece(Square sq) const {
-  if (m_w_pawns.test(sq)) return Piece('P');
-  if (m_w_knights.test(sq)) return Piece('N');
-  if (m_w_bishops.test(sq)) return Piece('B');
-  if (m_w_rooks.test(sq)) return Piece('R');
-  if (m_w_queen.test(sq)) return Piece('Q');
-  if (m_w_king.test(sq)) return Piece('K');
-
-  if (m_b_pawns.test(sq)) return Piece('p');
-  if (m_b_knights.test(sq)) return Piece('n');
-  if (m_b_bishops.test(sq)) return Piece('b');
-  if (m_b_rooks.test(sq)) return Piece('r');
-  if (m_b_queen.test(sq)) return Piece('q');
-  if (m_b_king.test(sq)) return Piece('k');
-
-  return Piece('.');  // NO_PIECE
+  // Restores side to move, castling rights, en passant square and clocks at once
+  m_state = undo.state;
+  m_hash = undo.hash;
 }
 
-void Board::set_piece(Square sq, Piece p) {
-  // Remove any existing piece if existent
-  const Piece existing_piece = get_piece(sq);
-  if (!existing_piece.is_none()) {
-    remove_piece(sq);
+void Board::set_white_turn(bool is_white_turn) {
+  if (is_white_turn != this->is_white_turn()) {
+    m_hash ^= Zobrist::SIDE_TO_MOVE;
+    m_state.side_to_move = is_white_turn ? Piece::WHITE : Piece::BLACK;
   }
+}
+
+void Board::set_castling_rights(uint8_t rights) {
+  m_hash ^= Zobrist::CASTLING[m_state.castling_rights] ^ Zobrist::CASTLING[rights];
+  m_state.castling_rights = rights;
+}
+
+void Board::set_en_passant_square(std::optional<Square> sq) {
+  if (m_state.en_passant != NO_EN_PASSANT) m_hash ^= Zobrist::EN_PASSANT_FILE[m_state.en_passant % 8];
+  if (sq) m_hash ^= Zobrist::EN_PASSANT_FILE[sq->file()];
+  m_state.en_passant = sq ? static_cast<uint8_t>(sq->value()) : NO_EN_PASSANT;
+}
 
-  switch (p.type()) {
-      // clang-format off
-      case Piece::P:  m_w_pawns.set(sq);   return;
-      case Piece::N:  m_w_knights.set(sq); return;
-      case Piece::B:  m_w_bishops.set(sq); return;
-      case Piece::R:  m_w_rooks.set(sq);   return;
-      case Piece::Q:  m_w_queen.set(sq);   return;
-      case Piece::K:  m_w_king.set(sq);    return;
-      case Piece::p:  m_b_pawns.set(sq);   return;
-      case Piece::n:  m_b_knights.set(sq); return;
-      case Piece::b:  m_b_bishops.set(sq); return;
-      case Piece::r:  m_b_rooks.set(sq);   return;
-      case Piece::q:  m_b_queen.set(sq);   return;
-      case Piece::k:  m_b_king.set(sq);    return;
-      case Piece::NO_PIECE:                return;
-    // clang-format on
-    default:
-      const std::string msg =
-          fmt::format("Piece {} does not exist, cannot set a piece on square {}", p.to_char(), sq.to_string());
-      throw std::invalid_argument(msg);
+uint64_t Board::compute_hash() const {
+  uint64_t hash = 0ULL;
+  for (int index = 0; index < 64; ++index) {
+    if (m_mailbox[index] != Piece::NO_PIECE) hash ^= Zobrist::PIECE_SQUARE[m_mailbox[index]][index];
   }
+  if (!is_white_turn()) hash ^= Zobrist::SIDE_TO_MOVE;
+  hash ^= Zobrist::CASTLING[m_state.castling_rights];
+  if (m_state.en_passant != NO_EN_PASSANT) hash ^= Zobrist::EN_PASSANT_FILE[m_state.en_passant % 8];
+  return hash;
 }
 
-void Board::remove_piece(Square sq) {
-  // clear the square from ALL bitboards (only one will match)
-  m_w_pawns.clear(sq);
-  m_w_knights.clear(sq);
-  m_w_bishops.clear(sq);
-  m_w_rooks.clear(sq);
-  m_w_queen.clear(sq);
-  m_w_king.clear(sq);
-
-  m_b_pawns.clear(sq);
-  m_b_knights.clear(sq);
-  m_b_bishops.clear(sq);
-  m_b_rooks.clear(sq);
-  m_b_queen.clear(sq);
-  m_b_king.clear(sq);
+bool Board::is_consistent() const {
+  for (int index = 0; index < 64; ++index) {
+    const Square sq = Square::unchecked(index);
+    for (int type = Piece::P; type < Piece::NO_PIECE; ++type) {
+      if (m_pieces[type].test(sq) != (m_mailbox[index] == type)) return false;
+    }
+  }
+
+  std::array<Bitboard, 2> colors;
+  for (int type = Piece::P; type < Piece::NO_PIECE; ++type) {
+    colors[Piece(static_cast<Piece::Type>(type)).color()] |= m_pieces[type];
+  }
+  return colors == m_colors && (colors[Piece::WHITE] | colors[Piece::BLACK]) == m_occupied;
 }
 
 void Board::print() const {
@@ -0,0 +1,276 @@
+#include <chess_engine/attacks/setwise.hpp>
+#include <chess_engine/bitmasks.hpp>
+#include <chess_engine/board_batch.hpp>
+#include <chess_engine/cpu.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define CHESS_ENGINE_BATCH_AVX2
+#if defined(__GNUC__) || defined(__clang__)
+#define CHESS_ENGINE_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define CHESS_ENGINE_AVX2_TARGET
+#endif
+#endif
+
+void BoardBatch::reserve(std::size_t capacity) {
+  for (std::vector<uint64_t>& bitboards : m_pieces) bitboards.reserve(capacity);
+}
+
+void BoardBatch::clear() {
+  for (std::vector<uint64_t>& bitboards : m_pieces) bitboards.clear();
+}
+
+void BoardBatch::push_back(const Board& board) {
+  for (int type = Piece::P; type <= Piece::k; ++type) {
+    m_pieces[type].push_back(board.pieces(static_cast<Piece::Type>(type)).value());
+  }
+}
+
+namespace {
+
+using namespace Bitmasks;
+
+/**
+ * Pointers to the six piece bitboard arrays of one color, in P, N, B, R, Q, K order.
+ */
+struct ColorArrays {
+  const uint64_t* pieces[6];
+
+  ColorArrays(const BoardBatch& batch, Piece::Color color) {
+    for (int kind = Piece::P; kind <= Piece::K; ++kind) {
+      pieces[kind] = batch.pieces(Piece::make_type(color, static_cast<Piece::Type>(kind))).data();
+    }
+  }
+
+  uint64_t occupancy(std::size_t i) const {
+    return pieces[Piece::P][i] | pieces[Piece::N][i] | pieces[Piece::B][i] | pieces[Piece::R][i] |
+           pieces[Piece::Q][i] | pieces[Piece::K][i];
+  }
+};
+
+constexpr uint64_t scalar_pawn_attacks(uint64_t pawns, bool white) {
+  return white ? ((pawns << 7) & ~FILE_H) | ((pawns << 9) & ~FILE_A)
+               : ((pawns >> 9) & ~FILE_H) | ((pawns >> 7) & ~FILE_A);
+}
+
+BatchKernels::Backend default_backend() {
+#if defined(CHESS_ENGINE_BATCH_AVX2)
+  if (Cpu::has_avx2()) return BatchKernels::Backend::Avx2;
+#endif
+  return BatchKernels::Backend::Scalar;
+}
+
+BatchKernels::Backend active_backend = default_backend();
+
+#if defined(CHESS_ENGINE_BATCH_AVX2)
+
+/*
+ * AVX2 kernels: each processes the positions in groups of four and returns the number of positions done,
+ * the caller finishing the remaining ones with the scalar code.
+ */
+namespace avx2 {
+
+CHESS_ENGINE_AVX2_TARGET inline __m256i load(const uint64_t* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+CHESS_ENGINE_AVX2_TARGET inline void store(uint64_t* p, __m256i v) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+CHESS_ENGINE_AVX2_TARGET inline __m256i splat(uint64_t value) {
+  return _mm256_set1_epi64x(static_cast<long long>(value));
+}
+
+template <int Shift>
+CHESS_ENGINE_AVX2_TARGET inline __m256i shift_signed(__m256i v) {
+  if constexpr (Shift > 0) {
+    return _mm256_slli_epi64(v, Shift);
+  } else {
+    return _mm256_srli_epi64(v, -Shift);
+  }
+}
+
+/**
+ * Same Kogge-Stone occluded fill as Attacks::detail::directional_attacks, on four positions at once.
+ */
+template <int Shift, uint64_t Wrap>
+CHESS_ENGINE_AVX2_TARGET inline __m256i directional_attacks(__m256i gen, __m256i empty) {
+  const __m256i wrap = splat(~Wrap);
+  __m256i pro = _mm256_and_si256(empty, wrap);
+  gen = _mm256_or_si256(gen, _mm256_and_si256(pro, shift_signed<Shift>(gen)));
+  pro = _mm256_and_si256(pro, shift_signed<Shift>(pro));
+  gen = _mm256_or_si256(gen, _mm256_and_si256(pro, shift_signed<2 * Shift>(gen)));
+  pro = _mm256_and_si256(pro, shift_signed<2 * Shift>(pro));
+  gen = _mm256_or_si256(gen, _mm256_and_si256(pro, shift_signed<4 * Shift>(gen)));
+  return _mm256_and_si256(shift_signed<Shift>(gen), wrap);
+}
+
+CHESS_ENGINE_AVX2_TARGET inline __m256i occupancy(const ColorArrays& arrays, std::size_t i) {
+  __m256i occ = load(arrays.pieces[0] + i);
+  for (int kind = 1; kind < 6; ++kind) occ = _mm256_or_si256(occ, load(arrays.pieces[kind] + i));
+  return occ;
+}
+
+CHESS_ENGINE_AVX2_TARGET std::size_t occupancy(const ColorArrays& arrays, uint64_t* out, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) store(out + i, occupancy(arrays, i));
+  return i;
+}
+
+CHESS_ENGINE_AVX2_TARGET std::size_t occupancy(const ColorArrays& white, const ColorArrays& black, uint64_t* out,
+                                               std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) store(out + i, _mm256_or_si256(occupancy(white, i), occupancy(black, i)));
+  return i;
+}
+
+CHESS_ENGINE_AVX2_TARGET std::size_t pawn_attacks(const uint64_t* pawns, bool white, uint64_t* out, std::size_t n) {
+  const __m256i not_a = splat(~FILE_A);
+  const __m256i not_h = splat(~FILE_H);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256i p = load(pawns + i);
+    const __m256i west = white ? _mm256_slli_epi64(p, 7) : _mm256_srli_epi64(p, 9);
+    const __m256i east = white ? _mm256_slli_epi64(p, 9) : _mm256_srli_epi64(p, 7);
+    store(out + i, _mm256_or_si256(_mm256_and_si256(west, not_h), _mm256_and_si256(east, not_a)));
+  }
+  return i;
+}
+
+template <bool Orthogonal>
+CHESS_ENGINE_AVX2_TARGET std::size_t slider_attacks(const ColorArrays& us, const ColorArrays& them, uint64_t* out,
+                                                    std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256i gen = _mm256_or_si256(load(us.pieces[Orthogonal ? Piece::R : Piece::B] + i),
+                                        load(us.pieces[Piece::Q] + i));
+    // andnot(a, b) = ~a & b
+    const __m256i empty = _mm256_andnot_si256(_mm256_or_si256(occupancy(us, i), occupancy(them, i)), splat(~0ULL));
+    __m256i attacks;
+    if constexpr (Orthogonal) {
+      attacks = _mm256_or_si256(
+          _mm256_or_si256(directional_attacks<8, 0ULL>(gen, empty), directional_attacks<-8, 0ULL>(gen, empty)),
+          _mm256_or_si256(directional_attacks<1, FILE_A>(gen, empty), directional_attacks<-1, FILE_H>(gen, empty)));
+    } else {
+      attacks = _mm256_or_si256(
+          _mm256_or_si256(directional_attacks<9, FILE_A>(gen, empty), directional_attacks<7, FILE_H>(gen, empty)),
+          _mm256_or_si256(directional_attacks<-7, FILE_A>(gen, empty), directional_attacks<-9, FILE_H>(gen, empty)));
+    }
+    store(out + i, attacks);
+  }
+  return i;
+}
+
+}  // namespace avx2
+
+#endif
+
+bool use_avx2() {
+#if defined(CHESS_ENGINE_BATCH_AVX2)
+  return active_backend == BatchKernels::Backend::Avx2;
+#else
+  return false;
+#endif
+}
+
+Piece::Color opponent(Piece::Color color) { return color == Piece::WHITE ? Piece::BLACK : Piece::WHITE; }
+
+}  // namespace
+
+namespace BatchKernels {
+
+Backend backend() { return active_backend; }
+
+const char* backend_name(Backend backend) {
+  switch (backend) {
+    case Backend::Scalar:
+      return "scalar";
+    case Backend::Avx2:
+      return "avx2";
+  }
+  return "unknown";
+}
+
+bool backend_supported(Backend backend) {
+  switch (backend) {
+    case Backend::Scalar:
+      return true;
+    case Backend::Avx2:
+#if defined(CHESS_ENGINE_BATCH_AVX2)
+      return Cpu::has_avx2();
+#else
+      return false;
+#endif
+  }
+  return false;
+}
+
+bool select_backend(Backend backend) {
+  if (!backend_supported(backend)) return false;
+  active_backend = backend;
+  return true;
+}
+
+void occupancy(const BoardBatch& batch, Piece::Color color, std::span<uint64_t> out) {
+  const ColorArrays arrays(batch, color);
+  const std::size_t n = batch.size();
+  std::size_t i = 0;
+#if defined(CHESS_ENGINE_BATCH_AVX2)
+  if (use_avx2()) i = avx2::occupancy(arrays, out.data(), n);
+#endif
+  for (; i < n; ++i) out[i] = arrays.occupancy(i);
+}
+
+void occupancy(const BoardBatch& batch, std::span<uint64_t> out) {
+  const ColorArrays white(batch, Piece::WHITE);
+  const ColorArrays black(batch, Piece::BLACK);
+  const std::size_t n = batch.size();
+  std::size_t i = 0;
+#if defined(CHESS_ENGINE_BATCH_AVX2)
+  if (use_avx2()) i = avx2::occupancy(white, black, out.data(), n);
+#endif
+  for (; i < n; ++i) out[i] = white.occupancy(i) | black.occupancy(i);
+}
+
+void pawn_attacks(const BoardBatch& batch, Piece::Color color, std::span<uint64_t> out) {
+  const uint64_t* pawns = batch.pieces(Piece::make_type(color, Piece::P)).data();
+  const bool white = color == Piece::WHITE;
+  const std::size_t n = batch.size();
+  std::size_t i = 0;
+#if defined(CHESS_ENGINE_BATCH_AVX2)
+  if (use_avx2()) i = avx2::pawn_attacks(pawns, white, out.data(), n);
+#endif
+  for (; i < n; ++i) out[i] = scalar_pawn_attacks(pawns[i], white);
+}
+
+void rook_attacks(const BoardBatch& batch, Piece::Color color, std::span<uint64_t> out) {
+  const ColorArrays us(batch, color);
+  const ColorArrays them(batch, opponent(color));
+  const std::size_t n = batch.size();
+  std::size_t i = 0;
+#if defined(CHESS_ENGINE_BATCH_AVX2)
+  if (use_avx2()) i = avx2::slider_attacks<true>(us, them, out.data(), n);
+#endif
+  for (; i < n; ++i) {
+    const Bitboard empty(~(us.occupancy(i) | them.occupancy(i)));
+    out[i] = Attacks::rook_attacks_setwise(us.pieces[Piece::R][i] | us.pieces[Piece::Q][i], empty).value();
+  }
+}
+
+void bishop_attacks(const BoardBatch& batch, Piece::Color color, std::span<uint64_t> out) {
+  const ColorArrays us(batch, color);
+  const ColorArrays them(batch, opponent(color));
+  const std::size_t n = batch.size();
+  std::size_t i = 0;
+#if defined(CHESS_ENGINE_BATCH_AVX2)
+  if (use_avx2()) i = avx2::slider_attacks<false>(us, them, out.data(), n);
+#endif
+  for (; i < n; ++i) {
+    const Bitboard empty(~(us.occupancy(i) | them.occupancy(i)));
+    out[i] = Attacks::bishop_attacks_setwise(us.pieces[Piece::B][i] | us.pieces[Piece::Q][i], empty).value();
+  }
+}
+
+}  // namespace BatchKernels
@@ -0,0 +1,106 @@
+#include <chess_engine/cpu.hpp>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define CHESS_ENGINE_X86_CPUID
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define CHESS_ENGINE_X86_CPUID
+#endif
+
+namespace {
+
+struct CpuidRegisters {
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+};
+
+CpuidRegisters cpuid(unsigned int leaf, unsigned int subleaf = 0) {
+  CpuidRegisters regs;
+#if defined(CHESS_ENGINE_X86_CPUID) && defined(_MSC_VER)
+  int info[4];
+  __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+  regs.eax = info[0];
+  regs.ebx = info[1];
+  regs.ecx = info[2];
+  regs.edx = info[3];
+#elif defined(CHESS_ENGINE_X86_CPUID)
+  __cpuid_count(leaf, subleaf, regs.eax, regs.ebx, regs.ecx, regs.edx);
+#else
+  (void)leaf;
+  (void)subleaf;
+#endif
+  return regs;
+}
+
+/**
+ * Reads the XCR0 register, listing the register states the OS saves on context switches.
+ * Only valid when CPUID reports OSXSAVE.
+ */
+uint64_t xgetbv0() {
+#if defined(CHESS_ENGINE_X86_CPUID) && defined(_MSC_VER)
+  return _xgetbv(0);
+#elif defined(CHESS_ENGINE_X86_CPUID)
+  // Encoded directly, the _xgetbv intrinsic would require compiling with -mxsave
+  unsigned int eax = 0, edx = 0;
+  __asm__ volatile(".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#else
+  return 0;
+#endif
+}
+
+struct CpuFeatures {
+  bool bmi2 = false;
+  bool avx2 = false;
+  bool zen1_or_zen2 = false;
+
+  CpuFeatures() {
+#if defined(CHESS_ENGINE_X86_CPUID)
+    const CpuidRegisters vendor = cpuid(0);
+    const unsigned int max_leaf = vendor.eax;
+
+    // Vendor string is stored in EBX, EDX, ECX order
+    char name[13] = {};
+    std::memcpy(name, &vendor.ebx, 4);
+    std::memcpy(name + 4, &vendor.edx, 4);
+    std::memcpy(name + 8, &vendor.ecx, 4);
+
+    // Leaf 1, ECX: bit 27 = OSXSAVE, bit 28 = AVX. XCR0 bits 1 and 2: SSE and AVX states saved by the OS
+    const unsigned int leaf1_ecx = cpuid(1).ecx;
+    const bool avx_usable = ((leaf1_ecx >> 27) & 1U) && ((leaf1_ecx >> 28) & 1U) && (xgetbv0() & 0x6) == 0x6;
+
+    if (max_leaf >= 7) {
+      // Leaf 7, sub-leaf 0: EBX bit 5 = AVX2, EBX bit 8 = BMI2
+      const unsigned int leaf7_ebx = cpuid(7, 0).ebx;
+      avx2 = avx_usable && ((leaf7_ebx >> 5) & 1U);
+      bmi2 = (leaf7_ebx >> 8) & 1U;
+    }
+
+    if (std::strcmp(name, "AuthenticAMD") == 0) {
+      // Leaf 1, EAX: family = base family (bits 8-11) + extended family (bits 20-27)
+      const unsigned int signature = cpuid(1).eax;
+      const unsigned int family = ((signature >> 8) & 0xFU) + ((signature >> 20) & 0xFFU);
+      zen1_or_zen2 = family == 0x17;
+    }
+#endif
+  }
+};
+
+const CpuFeatures& features() {
+  static const CpuFeatures detected;
+  return detected;
+}
+
+}  // namespace
+
+namespace Cpu {
+
+bool has_bmi2() { return features().bmi2; }
+
+bool has_fast_pext() { return features().bmi2 && !features().zen1_or_zen2; }
+
+bool has_avx2() { return features().avx2; }
+
+}  // namespace Cpu
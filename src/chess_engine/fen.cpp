@@ -0,0 +1,287 @@
+#include <charconv>
+#include <chess_engine/board.hpp>
+#include <chess_engine/fen.hpp>
+#include <cstring>
+#include <optional>
+
+namespace {
+
+/**
+ * Returns the field starting at `pos`, up to the next space or the end of the input.
+ */
+constexpr std::string_view field_at(std::string_view fen, std::size_t pos) {
+  const std::size_t end = fen.find(' ', pos);
+  return fen.substr(pos, end == std::string_view::npos ? std::string_view::npos : end - pos);
+}
+
+/**
+ * Parses a non-negative decimal number filling the whole field, at most 65535 to fit the packed board state.
+ */
+bool parse_clock(std::string_view field, uint16_t& value) {
+  const char* end = field.data() + field.size();
+  const auto [ptr, ec] = std::from_chars(field.data(), end, value);
+  return ec == std::errc() && ptr == end;
+}
+
+/**
+ * Returns the index just past the ';' ending the EPD operation starting at `pos`, npos if there is none.
+ * Semicolons inside double-quoted string operands do not end the operation.
+ */
+constexpr std::size_t operation_end(std::string_view fen, std::size_t pos) {
+  bool quoted = false;
+  for (; pos < fen.size(); ++pos) {
+    if (fen[pos] == '"') quoted = !quoted;
+    if (fen[pos] == ';' && !quoted) return pos + 1;
+  }
+  return std::string_view::npos;
+}
+
+constexpr bool is_letter(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+
+}  // namespace
+
+const char* FenError::message() const {
+  switch (code) {
+    case MISSING_FIELD:
+      return "missing field";
+    case INVALID_PIECE:
+      return "invalid piece character";
+    case INVALID_RANK_SIZE:
+      return "rank does not describe 8 squares";
+    case INVALID_RANK_COUNT:
+      return "placement does not describe 8 ranks";
+    case INVALID_PAWN_RANK:
+      return "pawn on the first or last rank";
+    case INVALID_KING_COUNT:
+      return "placement does not have exactly one king per side";
+    case INVALID_PIECE_COUNT:
+      return "placement has more than 16 pieces per side";
+    case INVALID_SIDE:
+      return "invalid side to move";
+    case INVALID_CASTLING:
+      return "invalid castling rights";
+    case INVALID_EN_PASSANT:
+      return "invalid en passant square";
+    case INVALID_CLOCK:
+      return "invalid halfmove clock or fullmove number";
+    case INVALID_EPD_OPERATION:
+      return "EPD operation is not an opcode with operands ended by ';'";
+    case TRAILING_CHARACTERS:
+      return "unexpected characters after the last field";
+  }
+  return "unknown error";
+}
+
+std::expected<Board, FenError> Board::from_fen(std::string_view fen) {
+  /*
+   * https://en.wikipedia.org/wiki/Forsyth%E2%80%93Edwards_Notation
+   *
+   * FEN (Forsyth-Edwards Notation) has 6 fields separated by spaces:
+   *
+   * 1. Piece placement (ranks 8 → 1, separated by /).
+   * 2. Side to move (w or b).
+   * 3. Castling availability (KQkq or -).
+   * 4. En passant target square (like e3 or -).
+   * 5. Halfmove clock (for 50-move rule).
+   * 6. Fullmove number (starts at 1).
+   *
+   * Example FEN for starting position: "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+   *
+   * EPD records (the first 4 fields followed by operations) are accepted as well.
+   */
+  Board board{EmptyTag{}};
+  std::size_t pos = 0;
+  auto fail = [&](FenError::Code code) { return std::unexpected(FenError{code, pos}); };
+
+  // Moves past the space ending the current field, fails if there is no next field
+  auto next_field = [&]() {
+    if (pos >= fen.size() || fen[pos] != ' ' || pos + 1 >= fen.size()) return false;
+    ++pos;
+    return true;
+  };
+
+  // 1. Piece placement, rank 8 first, files a to h within a rank
+  int rank = 7;
+  int file = 0;
+  for (; pos < fen.size() && fen[pos] != ' '; ++pos) {
+    const char c = fen[pos];
+    if (c == '/') {
+      if (file != 8) return fail(FenError::INVALID_RANK_SIZE);
+      if (rank == 0) return fail(FenError::INVALID_RANK_COUNT);
+      --rank;
+      file = 0;
+    } else if (c >= '1' && c <= '8') {
+      file += c - '0';
+      if (file > 8) return fail(FenError::INVALID_RANK_SIZE);
+    } else {
+      const std::optional<Piece> piece = Piece::from_char(c);
+      if (!piece || piece->is_none()) return fail(FenError::INVALID_PIECE);
+      if (file == 8) return fail(FenError::INVALID_RANK_SIZE);
+      const bool pawn = piece->type() == Piece::P || piece->type() == Piece::p;
+      if (pawn && (rank == 0 || rank == 7)) return fail(FenError::INVALID_PAWN_RANK);
+      board.put_piece(piece->type(), Square::unchecked(file, rank));
+      ++file;
+    }
+  }
+  if (file != 8) return fail(FenError::INVALID_RANK_SIZE);
+  if (rank != 0) return fail(FenError::INVALID_RANK_COUNT);
+  // Move generation and check detection look the kings up: reported at the start of the placement field
+  if (board.pieces(Piece::K).popcount() != 1 || board.pieces(Piece::k).popcount() != 1) {
+    return std::unexpected(FenError{FenError::INVALID_KING_COUNT, 0});
+  }
+  // A game never has more, and the exchange evaluation sizes its swap list on real positions
+  if (board.pieces(Piece::WHITE).popcount() > 16 || board.pieces(Piece::BLACK).popcount() > 16) {
+    return std::unexpected(FenError{FenError::INVALID_PIECE_COUNT, 0});
+  }
+
+  // 2. Side to move
+  if (!next_field()) return fail(FenError::MISSING_FIELD);
+  const std::string_view side = field_at(fen, pos);
+  if (side != "w" && side != "b") return fail(FenError::INVALID_SIDE);
+  board.m_state.side_to_move = side == "w" ? Piece::WHITE : Piece::BLACK;
+  pos += side.size();
+
+  // 3. Castling rights: '-' or each of K, Q, k, q at most once
+  if (!next_field()) return fail(FenError::MISSING_FIELD);
+  const std::string_view castling = field_at(fen, pos);
+  if (castling != "-") {
+    uint8_t rights = 0;
+    for (const char c : castling) {
+      uint8_t right = 0;
+      switch (c) {  // clang-format off
+        case 'K': right = WHITE_KINGSIDE; break;
+        case 'Q': right = WHITE_QUEENSIDE; break;
+        case 'k': right = BLACK_KINGSIDE; break;
+        case 'q': right = BLACK_QUEENSIDE; break;
+        default: return fail(FenError::INVALID_CASTLING);
+      }  // clang-format on
+      if (rights & right) return fail(FenError::INVALID_CASTLING);
+      rights |= right;
+    }
+    board.m_state.castling_rights = rights;
+  }
+  pos += castling.size();
+
+  /*
+   * 4. En passant target square, on the 3rd or 6th rank.
+   * It is dropped unless the position could follow a double push (the pushed pawn in front of it, the square and the
+   * pawn's origin empty) and, as in make_move(), a pawn of the side to move can capture on it, so that the position
+   * gets the same Zobrist key as when reached by the double push.
+   */
+  if (!next_field()) return fail(FenError::MISSING_FIELD);
+  const std::string_view en_passant = field_at(fen, pos);
+  if (en_passant != "-") {
+    if (en_passant.size() != 2 || en_passant[0] < 'a' || en_passant[0] > 'h' ||
+        (en_passant[1] != '3' && en_passant[1] != '6')) {
+      return fail(FenError::INVALID_EN_PASSANT);
+    }
+    const Square skipped = Square::unchecked(en_passant[0] - 'a', en_passant[1] - '1');
+    const bool white_to_move = board.is_white_turn();
+    const int forward = white_to_move ? -8 : 8;  // from the skipped square towards the pushed pawn
+    const Square victim = Square::unchecked(skipped.value() + forward);
+    const Square origin = Square::unchecked(skipped.value() - forward);
+    const bool after_double_push = en_passant[1] == (white_to_move ? '6' : '3') &&
+                                   board.pieces(white_to_move ? Piece::p : Piece::P).test(victim) &&
+                                   !board.occupied().test(skipped) && !board.occupied().test(origin);
+    if (after_double_push && board.en_passant_capturable(skipped, board.side_to_move())) {
+      board.m_state.en_passant = static_cast<uint8_t>(skipped.value());
+    }
+  }
+  pos += en_passant.size();
+
+  // 5. and 6. Halfmove clock and fullmove number, both optional
+  if (pos < fen.size() && !(pos + 1 < fen.size() && is_letter(fen[pos + 1]))) {
+    if (!next_field()) return fail(FenError::TRAILING_CHARACTERS);
+    const std::string_view halfmove = field_at(fen, pos);
+    if (!parse_clock(halfmove, board.m_state.halfmove_clock)) return fail(FenError::INVALID_CLOCK);
+    pos += halfmove.size();
+
+    if (!next_field()) return fail(FenError::MISSING_FIELD);
+    const std::string_view fullmove = field_at(fen, pos);
+    if (!parse_clock(fullmove, board.m_state.fullmove_number)) return fail(FenError::INVALID_CLOCK);
+    pos += fullmove.size();
+  }
+
+  /*
+   * EPD operations (https://www.chessprogramming.org/Extended_Position_Description), optional:
+   * an opcode and its operands ended by ';', as in `bm Nf3; id "WAC.001";`.
+   * hmvc and fmvn give the clocks, the other operations are skipped.
+   */
+  while (pos < fen.size()) {
+    if (!next_field()) return fail(FenError::TRAILING_CHARACTERS);
+    if (!is_letter(fen[pos])) return fail(FenError::INVALID_EPD_OPERATION);
+    const std::size_t end = operation_end(fen, pos);
+    if (end == std::string_view::npos) return fail(FenError::INVALID_EPD_OPERATION);
+
+    const std::string_view operation = fen.substr(pos, end - 1 - pos);
+    const std::string_view opcode = operation.substr(0, operation.find(' '));
+    if (opcode == "hmvc" || opcode == "fmvn") {
+      uint16_t& clock = opcode == "hmvc" ? board.m_state.halfmove_clock : board.m_state.fullmove_number;
+      if (operation.size() <= opcode.size() + 1 || !parse_clock(operation.substr(opcode.size() + 1), clock)) {
+        return fail(FenError::INVALID_EPD_OPERATION);
+      }
+    }
+    pos = end;
+  }
+
+  board.m_hash = board.compute_hash();
+  return board;
+}
+
+std::size_t Board::to_fen(std::span<char> buffer) const {
+  // Assembled on the stack first: any position fits, and the caller's buffer is only written if it is large enough
+  char text[MAX_FEN_LENGTH];
+  char* out = text;
+
+  for (int rank = 7; rank >= 0; --rank) {
+    int empty = 0;
+    for (int file = 0; file < 8; ++file) {
+      const Piece::Type type = m_mailbox[rank * 8 + file];
+      if (type == Piece::NO_PIECE) {
+        ++empty;
+        continue;
+      }
+      if (empty) *out++ = static_cast<char>('0' + empty);
+      empty = 0;
+      *out++ = Piece(type).to_char();
+    }
+    if (empty) *out++ = static_cast<char>('0' + empty);
+    if (rank) *out++ = '/';
+  }
+
+  *out++ = ' ';
+  *out++ = is_white_turn() ? 'w' : 'b';
+
+  *out++ = ' ';
+  const uint8_t rights = castling_rights();
+  if (!rights) *out++ = '-';
+  if (rights & WHITE_KINGSIDE) *out++ = 'K';
+  if (rights & WHITE_QUEENSIDE) *out++ = 'Q';
+  if (rights & BLACK_KINGSIDE) *out++ = 'k';
+  if (rights & BLACK_QUEENSIDE) *out++ = 'q';
+
+  *out++ = ' ';
+  if (m_state.en_passant != NO_EN_PASSANT) {
+    *out++ = static_cast<char>('a' + m_state.en_passant % 8);
+    *out++ = static_cast<char>('1' + m_state.en_passant / 8);
+  } else {
+    *out++ = '-';
+  }
+
+  // A clock takes at most 5 digits; the fields above take at most 84 characters, leaving room for both
+  *out++ = ' ';
+  out = std::to_chars(out, out + 5, m_state.halfmove_clock).ptr;
+  *out++ = ' ';
+  out = std::to_chars(out, out + 5, m_state.fullmove_number).ptr;
+
+  const std::size_t length = static_cast<std::size_t>(out - text);
+  if (buffer.size() < length) return 0;
+  std::memcpy(buffer.data(), text, length);
+  if (buffer.size() > length) buffer[length] = '\0';
+  return length;
+}
+
+std::string Board::to_fen() const {
+  char buffer[MAX_FEN_LENGTH];
+  return std::string(buffer, to_fen(buffer));
+}
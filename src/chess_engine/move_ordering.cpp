@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <chess_engine/move_ordering.hpp>
+#include <chess_engine/see.hpp>
+#include <cstdlib>
+
+namespace {
+
+bool is_queen_promotion(Move move) {
+  return move.type() == Move::PROMOTION && move.promotion_type(Piece::WHITE) == Piece::Q;
+}
+
+/** History update of a cutoff at a given depth: quadratic in depth, capped so one deep node cannot saturate. */
+int history_bonus(int depth) { return std::min(16 * depth * depth, 1200); }
+
+}  // namespace
+
+namespace MoveOrdering {
+
+bool is_tactical(const Board& board, Move move) {
+  return move.type() == Move::EN_PASSANT || is_queen_promotion(move) ||
+         (move.type() != Move::CASTLING && !board.get_piece(move.to()).is_none());
+}
+
+int mvv_lva(const Board& board, Move move) {
+  const Piece::Type victim = move.type() == Move::EN_PASSANT ? Piece::P : board.get_piece(move.to()).type();
+  int score = victim == Piece::NO_PIECE ? 0 : 8 * (Piece(victim).kind() + 1);
+  if (is_queen_promotion(move)) score += 8 * (Piece::Q + 1);
+  return score + Piece::K - board.get_piece(move.from()).kind();
+}
+
+int tactical_score(const Board& board, Move move) {
+  return (See::see_ge(board, move, 0) ? GOOD_CAPTURE_SCORE : BAD_CAPTURE_SCORE) + mvv_lva(board, move);
+}
+
+}  // namespace MoveOrdering
+
+void History::clear() {
+  for (auto& killers : m_killers) killers.fill(Move());
+  for (auto& row : m_counter_moves) row.fill(Move());
+  for (auto& side : m_butterfly) {
+    for (auto& row : side) row.fill(0);
+  }
+  for (auto& previous_piece : m_continuation) {
+    for (auto& previous_to : previous_piece) {
+      for (auto& row : previous_to) row.fill(0);
+    }
+  }
+}
+
+void History::apply(int16_t& entry, int bonus) {
+  // Gravity: the closer the entry to the bound in the bonus direction, the smaller the update
+  entry = static_cast<int16_t>(entry + bonus - entry * std::abs(bonus) / MoveOrdering::HISTORY_MAX);
+}
+
+int History::quiet_score(const Board& board, Move move, PieceTo previous) const {
+  int score = m_butterfly[board.side_to_move()][move.from().value()][move.to().value()];
+  if (previous.piece != Piece::NO_PIECE) {
+    score += m_continuation[previous.piece][previous.to.value()][board.get_piece(move.from()).type()]
+                           [move.to().value()];
+  }
+  return score;
+}
+
+void History::update(const Board& board, Move best, std::span<const Move> tried, int depth, int ply,
+                     PieceTo previous) {
+  if (ply < MAX_PLY && m_killers[ply][0] != best) {
+    m_killers[ply][1] = m_killers[ply][0];
+    m_killers[ply][0] = best;
+  }
+  if (previous.piece != Piece::NO_PIECE) m_counter_moves[previous.piece][previous.to.value()] = best;
+
+  const int bonus = history_bonus(depth);
+  const auto reward = [&](Move move, int amount) {
+    apply(m_butterfly[board.side_to_move()][move.from().value()][move.to().value()], amount);
+    if (previous.piece != Piece::NO_PIECE) {
+      apply(m_continuation[previous.piece][previous.to.value()][board.get_piece(move.from()).type()]
+                          [move.to().value()],
+            amount);
+    }
+  };
+  reward(best, bonus);
+  for (const Move move : tried) reward(move, -bonus);
+}
+
+MovePicker::MovePicker(const Board& board, Move hash_move, const History* history, int ply,
+                       History::PieceTo previous)
+    : m_board(board), m_history(history), m_previous(previous) {
+  if (MoveGen::is_legal(board, hash_move)) m_hash_move = hash_move;
+  if (!history) return;
+
+  const bool has_killers = ply < History::MAX_PLY;
+  const std::array<Move, 3> candidates = {has_killers ? history->killer(ply, 0) : Move(),
+                                          has_killers ? history->killer(ply, 1) : Move(),
+                                          history->counter_move(previous)};
+  std::size_t count = 0;
+  for (const Move move : candidates) {
+    // A refutation from another node may be a capture or illegal here
+    if (move.is_null() || move == m_hash_move || is_refutation(move)) continue;
+    if (MoveOrdering::is_tactical(board, move) || !MoveGen::is_legal(board, move)) continue;
+    m_refutations[count++] = move;
+  }
+}
+
+Move MovePicker::next() {
+  switch (m_stage) {
+    case HASH_MOVE:
+      m_stage = GENERATE_CAPTURES;
+      if (!m_hash_move.is_null()) return m_hash_move;
+      [[fallthrough]];
+
+    case GENERATE_CAPTURES:
+      MoveGen::generate_captures(m_board, m_moves);
+      m_captures_end = m_end = m_moves.size();
+      for (std::size_t i = 0; i < m_end; ++i) m_scores[i] = MoveOrdering::tactical_score(m_board, m_moves[i]);
+      m_stage = GOOD_CAPTURES;
+      [[fallthrough]];
+
+    case GOOD_CAPTURES:
+      while (m_current < m_end) {
+        const Move move = pick_best();
+        if (m_scores[m_current - 1] < MoveOrdering::GOOD_CAPTURE_SCORE) {
+          --m_current;  // the remaining captures all lose material
+          break;
+        }
+        if (move != m_hash_move) return move;
+      }
+      m_bad_captures = m_current;
+      if (m_captures_only) {
+        m_stage = BAD_CAPTURES;
+        return next();
+      }
+      m_stage = REFUTATIONS;
+      [[fallthrough]];
+
+    case REFUTATIONS:
+      while (m_refutation < m_refutations.size()) {
+        const Move move = m_refutations[m_refutation++];
+        if (!move.is_null()) return move;
+      }
+      m_stage = GENERATE_QUIETS;
+      [[fallthrough]];
+
+    case GENERATE_QUIETS:
+      m_current = m_moves.size();
+      MoveGen::generate_quiets(m_board, m_moves);
+      m_end = m_moves.size();
+      for (std::size_t i = m_current; i < m_end; ++i) {
+        m_scores[i] = m_history ? m_history->quiet_score(m_board, m_moves[i], m_previous) : 0;
+      }
+      m_stage = QUIETS;
+      [[fallthrough]];
+
+    case QUIETS:
+      while (m_current < m_end) {
+        const Move move = pick_best();
+        if (move != m_hash_move && !is_refutation(move)) return move;
+      }
+      m_current = m_bad_captures;
+      m_end = m_captures_end;
+      m_stage = BAD_CAPTURES;
+      [[fallthrough]];
+
+    case BAD_CAPTURES:
+      while (m_current < m_end) {
+        const Move move = pick_best();
+        if (move != m_hash_move) return move;
+      }
+      m_stage = DONE;
+      [[fallthrough]];
+
+    case DONE:
+      break;
+  }
+  return Move();
+}
@@ -0,0 +1,394 @@
+#include <chess_engine/attacks/king.hpp>
+#include <chess_engine/attacks/knight.hpp>
+#include <chess_engine/attacks/lines.hpp>
+#include <chess_engine/attacks/pawn.hpp>
+#include <chess_engine/attacks/sliders.hpp>
+#include <chess_engine/bitmasks.hpp>
+#include <chess_engine/movegen.hpp>
+#include <cstdint>
+
+namespace {
+
+using namespace Bitmasks;
+
+constexpr Bitboard ALL_SQUARES = ~0ULL;
+
+constexpr Piece::Color opponent(Piece::Color color) { return color == Piece::WHITE ? Piece::BLACK : Piece::WHITE; }
+
+/**
+ * Emits one move per destination square, all from the same origin square.
+ */
+inline void add_moves(MoveList& moves, Square from, Bitboard targets) {
+  for (const Square to : targets) moves.push_back(Move(from, to));
+}
+
+/**
+ * Subset of the moves to generate. CAPTURES are the moves changing the material balance (captures, en passant
+ * and queen promotions), QUIETS all the others (under-promotions without capture and castling included).
+ */
+enum class GenType { ALL, CAPTURES, QUIETS };
+
+/**
+ * Emits the promotions of a pawn move: the queen one unless generating QUIETS, the under-promotions unless
+ * generating CAPTURES.
+ */
+template <GenType TYPE>
+inline void add_promotions(MoveList& moves, Square from, Square to) {
+  if constexpr (TYPE != GenType::QUIETS) moves.push_back(Move::make_promotion(from, to, Piece::Q));
+  if constexpr (TYPE != GenType::CAPTURES) {
+    for (Piece::Type promotion : {Piece::R, Piece::B, Piece::N}) {
+      moves.push_back(Move::make_promotion(from, to, promotion));
+    }
+  }
+}
+
+/**
+ * Emits pawn moves from a set of destination squares, all reached with the same step of STEP bits.
+ * Destinations on the last rank are expanded to the promotions of TYPE.
+ */
+template <GenType TYPE, int STEP>
+inline void add_pawn_moves(MoveList& moves, Bitboard targets, Bitboard promotion_rank) {
+  for (const Square to : targets) {
+    const Square from = Square::unchecked(to.value() - STEP);
+    if (promotion_rank.test(to)) {
+      add_promotions<TYPE>(moves, from, to);
+    } else {
+      moves.push_back(Move(from, to));
+    }
+  }
+}
+
+/**
+ * Shifts a bitboard one rank towards the opponent of `us`: north for White, south for Black.
+ */
+constexpr Bitboard forward(Bitboard bb, Piece::Color us) {
+  return us == Piece::WHITE ? bb.shift<NORTH>() : bb.shift<SOUTH>();
+}
+
+/**
+ * Pushes, double pushes, captures and promotions of the given pawns moving towards UP, restricted to the `allowed`
+ * destinations and to the moves of TYPE: CAPTURES keeps captures and queen push promotions, QUIETS the other
+ * pushes. En passant is handled separately.
+ */
+template <GenType TYPE, Direction UP>
+void generate_pawn_moves_towards(const Board& board, MoveList& moves, Bitboard pawns, Bitboard allowed) {
+  constexpr bool WHITE = UP == NORTH;
+  constexpr Direction UP_WEST = WHITE ? NORTH_WEST : SOUTH_WEST;
+  constexpr Direction UP_EAST = WHITE ? NORTH_EAST : SOUTH_EAST;
+  constexpr Bitboard DOUBLE_PUSH_RANK = WHITE ? RANK_3 : RANK_6;  // rank reached after the first step
+  constexpr Bitboard PROMOTION_RANK = WHITE ? RANK_8 : RANK_1;
+
+  const Bitboard empty = ~board.occupied();
+  const Bitboard enemies = board.pieces(WHITE ? Piece::BLACK : Piece::WHITE);
+
+  // Pushes (the intermediate square of a double push only has to be empty, not allowed)
+  const Bitboard single = pawns.shift<UP>() & empty;
+  const Bitboard double_push = (single & DOUBLE_PUSH_RANK).shift<UP>() & empty;
+  if constexpr (TYPE == GenType::CAPTURES) {
+    add_pawn_moves<TYPE, UP>(moves, single & PROMOTION_RANK & allowed, PROMOTION_RANK);
+  } else {
+    add_pawn_moves<TYPE, UP>(moves, single & allowed, PROMOTION_RANK);
+    add_pawn_moves<TYPE, 2 * UP>(moves, double_push & allowed, Bitboard());
+  }
+
+  // Captures towards the west (file - 1) and the east (file + 1), shift<>() drops the moves wrapping around the
+  // board; every promotion with a capture is a capture
+  if constexpr (TYPE != GenType::QUIETS) {
+    add_pawn_moves<GenType::ALL, UP_WEST>(moves, pawns.shift<UP_WEST>() & enemies & allowed, PROMOTION_RANK);
+    add_pawn_moves<GenType::ALL, UP_EAST>(moves, pawns.shift<UP_EAST>() & enemies & allowed, PROMOTION_RANK);
+  }
+}
+
+/**
+ * Pawn moves of TYPE for the pawns of `us`, see generate_pawn_moves_towards().
+ */
+template <GenType TYPE>
+void generate_pawn_moves(const Board& board, MoveList& moves, Piece::Color us, Bitboard pawns, Bitboard allowed) {
+  if (us == Piece::WHITE) {
+    generate_pawn_moves_towards<TYPE, NORTH>(board, moves, pawns, allowed);
+  } else {
+    generate_pawn_moves_towards<TYPE, SOUTH>(board, moves, pawns, allowed);
+  }
+}
+
+/**
+ * Our pawns able to capture on the en passant square, if any.
+ */
+inline Bitboard en_passant_capturers(const Board& board, Piece::Color us, Square target) {
+  const Bitboard sources = us == Piece::WHITE ? Attacks::BLACK_PAWN_ATTACKS[target.value()]
+                                              : Attacks::WHITE_PAWN_ATTACKS[target.value()];
+  return sources & board.pieces(Piece::make_type(us, Piece::P));
+}
+
+/**
+ * Square of the pawn taken by an en passant capture landing on `to`.
+ */
+constexpr Square en_passant_victim(Piece::Color us, Square to) {
+  const int behind = us == Piece::WHITE ? SOUTH : NORTH;
+  return Square::unchecked(to.value() + behind);
+}
+
+/**
+ * Castling moves, assuming the king is not in check. The king must not cross nor land on an attacked square
+ * when `check_destination` is set; pseudo-legal generation leaves the destination to the legality check.
+ */
+void generate_castling(const Board& board, MoveList& moves, Piece::Color us, bool check_destination) {
+  const bool white = us == Piece::WHITE;
+  const uint8_t rights = board.castling_rights();
+  const uint8_t kingside = white ? Board::WHITE_KINGSIDE : Board::BLACK_KINGSIDE;
+  const uint8_t queenside = white ? Board::WHITE_QUEENSIDE : Board::BLACK_QUEENSIDE;
+  if (!(rights & (kingside | queenside))) return;
+
+  const Piece::Color them = opponent(us);
+  const int king = white ? Square::E1 : Square::E8;
+  const Bitboard occupied = board.occupied();
+
+  // Squares between king and rook must be empty, the squares crossed by the king must not be attacked
+  if ((rights & kingside) && (occupied & Bitboard(0b11ULL << (king + 1))).empty() &&
+      !board.is_square_attacked(Square::unchecked(king + 1), them) &&
+      !(check_destination && board.is_square_attacked(Square::unchecked(king + 2), them))) {
+    moves.push_back(Move(Square::unchecked(king), Square::unchecked(king + 2), Move::CASTLING));
+  }
+  if ((rights & queenside) && (occupied & Bitboard(0b111ULL << (king - 3))).empty() &&
+      !board.is_square_attacked(Square::unchecked(king - 1), them) &&
+      !(check_destination && board.is_square_attacked(Square::unchecked(king - 2), them))) {
+    moves.push_back(Move(Square::unchecked(king), Square::unchecked(king - 2), Move::CASTLING));
+  }
+}
+
+/**
+ * Our pieces pinned to our king: each is our only piece between the king and an enemy slider on the same line.
+ * A pinned piece may only move along the line through the king and itself: the king and the pinner block it on
+ * either side, so this keeps it between them (capture of the pinner included).
+ */
+Bitboard pinned_pieces(const Board& board, Piece::Color us, Square king) {
+  using namespace Attacks;
+
+  const Piece::Color them = opponent(us);
+  const Bitboard occupied = board.occupied();
+  const Bitboard enemy_queens = board.pieces(Piece::make_type(them, Piece::Q));
+  const Bitboard snipers =
+      (ROOK_ATTACKS[king.value()] & (board.pieces(Piece::make_type(them, Piece::R)) | enemy_queens)) |
+      (BISHOP_ATTACKS[king.value()] & (board.pieces(Piece::make_type(them, Piece::B)) | enemy_queens));
+  Bitboard pinned;
+  for (const Square sniper : snipers) {
+    const Bitboard blockers = BETWEEN[king.value()][sniper.value()] & occupied;
+    if (!blockers.more_than_one() && !(blockers & board.pieces(us)).empty()) pinned |= blockers;
+  }
+  return pinned;
+}
+
+/**
+ * Checks that an en passant capture does not leave our king to a slider: removing two pawns from the same rank
+ * can expose it to a rook or queen (e.g. "8/8/8/K2pP2r/8/8/8/7k w - d6"), and a pinned capturer may leave its
+ * line. Checks by other pieces are left to the caller.
+ */
+bool en_passant_keeps_king_safe(const Board& board, Piece::Color us, Square king, Square from, Square to) {
+  using namespace Attacks;
+
+  const Piece::Color them = opponent(us);
+  const Bitboard enemy_queens = board.pieces(Piece::make_type(them, Piece::Q));
+  const Bitboard enemy_rooks = board.pieces(Piece::make_type(them, Piece::R)) | enemy_queens;
+  const Bitboard enemy_bishops = board.pieces(Piece::make_type(them, Piece::B)) | enemy_queens;
+  Bitboard after = board.occupied();
+  after.clear(from);
+  after.clear(en_passant_victim(us, to));
+  after.set(to);
+  return (rook_attacks(king, after) & enemy_rooks).empty() && (bishop_attacks(king, after) & enemy_bishops).empty();
+}
+
+/**
+ * Legal moves of TYPE, see MoveGen::generate_legal().
+ */
+template <GenType TYPE>
+void generate_legal_moves(const Board& board, MoveList& moves) {
+  using namespace Attacks;
+
+  const Piece::Color us = board.side_to_move();
+  const Piece::Color them = opponent(us);
+  const Square king = board.king_square(us);
+  const Bitboard own = board.pieces(us);
+  const Bitboard enemies = board.pieces(them);
+  const Bitboard occupied = board.occupied();
+
+  // Destinations of the pieces other than pawns: enemy pieces for captures, empty squares for quiet moves
+  const Bitboard kind_mask = TYPE == GenType::CAPTURES ? enemies
+                             : TYPE == GenType::QUIETS ? ~occupied
+                                                       : ALL_SQUARES;
+
+  // King moves: the destination must not be attacked once the king has left its square,
+  // otherwise a slider checking along a line would not "see" the square behind the king
+  Bitboard occupied_without_king = occupied;
+  occupied_without_king.clear(king);
+  for (const Square to : KING_ATTACKS[king.value()] & ~own & kind_mask) {
+    if ((board.attackers_to(to, occupied_without_king) & enemies).empty()) moves.push_back(Move(king, to));
+  }
+
+  const Bitboard checkers = board.attackers_to(king) & enemies;
+
+  // Double check: only the king can move
+  if (checkers.more_than_one()) return;
+
+  // Single check: other pieces must capture the checker or block the line between it and the king
+  const Bitboard check_mask =
+      checkers.empty() ? ALL_SQUARES : checkers | BETWEEN[king.value()][checkers.lsb().value()];
+
+  // In check, a pinned piece can never help: leaving its line exposes the king, and the line only meets the
+  // checking line on the king square, so pinned pieces are skipped altogether below
+  const Bitboard pinned = pinned_pieces(board, us, king);
+  const Bitboard targets = ~own & check_mask & kind_mask;
+
+  // Pawns
+  const Bitboard pawns = board.pieces(Piece::make_type(us, Piece::P));
+  generate_pawn_moves<TYPE>(board, moves, us, pawns & ~pinned, check_mask);
+  if (checkers.empty()) {
+    for (const Square from : pawns & pinned) {
+      Bitboard pawn;
+      pawn.set(from);
+      generate_pawn_moves<TYPE>(board, moves, us, pawn, LINE[king.value()][from.value()]);
+    }
+  }
+
+  // En passant: the captured pawn may be the checker
+  if constexpr (TYPE != GenType::QUIETS) {
+    if (const std::optional<Square> ep = board.en_passant_square()) {
+      if (check_mask.test(*ep) || check_mask.test(en_passant_victim(us, *ep))) {
+        for (const Square from : en_passant_capturers(board, us, *ep)) {
+          if (en_passant_keeps_king_safe(board, us, king, from, *ep)) {
+            moves.push_back(Move(from, *ep, Move::EN_PASSANT));
+          }
+        }
+      }
+    }
+  }
+
+  // Knights: a pinned knight can never stay on its pin line
+  for (const Square from : board.pieces(Piece::make_type(us, Piece::N)) & ~pinned) {
+    add_moves(moves, from, KNIGHT_ATTACKS[from.value()] & targets);
+  }
+
+  // Sliders: pinned ones are restricted to their pin ray (and have no move at all when in check)
+  const Bitboard queens = board.pieces(Piece::make_type(us, Piece::Q));
+  const Bitboard movable = checkers.empty() ? ALL_SQUARES : ~pinned;
+
+  for (const Square from : (board.pieces(Piece::make_type(us, Piece::B)) | queens) & movable) {
+    const Bitboard restriction = pinned.test(from) ? LINE[king.value()][from.value()] : ALL_SQUARES;
+    add_moves(moves, from, bishop_attacks(from, occupied) & targets & restriction);
+  }
+
+  for (const Square from : (board.pieces(Piece::make_type(us, Piece::R)) | queens) & movable) {
+    const Bitboard restriction = pinned.test(from) ? LINE[king.value()][from.value()] : ALL_SQUARES;
+    add_moves(moves, from, rook_attacks(from, occupied) & targets & restriction);
+  }
+
+  if constexpr (TYPE != GenType::CAPTURES) {
+    if (checkers.empty()) generate_castling(board, moves, us, true);
+  }
+}
+
+}  // namespace
+
+namespace MoveGen {
+
+void generate_pseudo_legal(const Board& board, MoveList& moves) {
+  const Piece::Color us = board.side_to_move();
+  const Bitboard targets = ~board.pieces(us);
+  const Bitboard occupied = board.occupied();
+
+  generate_pawn_moves<GenType::ALL>(board, moves, us, board.pieces(Piece::make_type(us, Piece::P)), ALL_SQUARES);
+  if (const std::optional<Square> ep = board.en_passant_square()) {
+    for (const Square from : en_passant_capturers(board, us, *ep)) moves.push_back(Move(from, *ep, Move::EN_PASSANT));
+  }
+
+  for (const Square from : board.pieces(Piece::make_type(us, Piece::N))) {
+    add_moves(moves, from, Attacks::KNIGHT_ATTACKS[from.value()] & targets);
+  }
+
+  const Bitboard queens = board.pieces(Piece::make_type(us, Piece::Q));
+
+  for (const Square from : board.pieces(Piece::make_type(us, Piece::B)) | queens) {
+    add_moves(moves, from, Attacks::bishop_attacks(from, occupied) & targets);
+  }
+
+  for (const Square from : board.pieces(Piece::make_type(us, Piece::R)) | queens) {
+    add_moves(moves, from, Attacks::rook_attacks(from, occupied) & targets);
+  }
+
+  const Square king = board.king_square(us);
+  add_moves(moves, king, Attacks::KING_ATTACKS[king.value()] & targets);
+
+  if (!board.is_square_attacked(king, opponent(us))) generate_castling(board, moves, us, false);
+}
+
+void generate_legal(const Board& board, MoveList& moves) { generate_legal_moves<GenType::ALL>(board, moves); }
+
+void generate_captures(const Board& board, MoveList& moves) { generate_legal_moves<GenType::CAPTURES>(board, moves); }
+
+void generate_quiets(const Board& board, MoveList& moves) { generate_legal_moves<GenType::QUIETS>(board, moves); }
+
+bool is_legal(const Board& board, Move move) {
+  using namespace Attacks;
+
+  const Piece::Color us = board.side_to_move();
+  const Piece::Color them = opponent(us);
+  const Piece piece = board.get_piece(move.from());
+  if (move.is_null() || piece.is_none() || piece.color() != us) return false;
+  // Only promotions use the promotion bits: other encodings of the same squares are never generated
+  if (move.type() != Move::PROMOTION && move != Move(move.from(), move.to(), move.type())) return false;
+
+  const Square from = move.from();
+  const Square to = move.to();
+  const Bitboard occupied = board.occupied();
+  if (board.pieces(us).test(to)) return false;
+
+  const Square king = board.king_square(us);
+  const Piece::Type kind = piece.kind();
+  if (move.type() == Move::CASTLING) {
+    if (kind != Piece::K || board.in_check()) return false;
+    MoveList castling;
+    generate_castling(board, castling, us, true);
+    return castling.contains(move);
+  }
+  if (kind == Piece::K) {
+    Bitboard occupied_without_king = occupied;
+    occupied_without_king.clear(king);
+    return move.type() == Move::NORMAL && KING_ATTACKS[from.value()].test(to) &&
+           (board.attackers_to(to, occupied_without_king) & board.pieces(them)).empty();
+  }
+
+  // Same check and pin rules as generate_legal()
+  const Bitboard checkers = board.attackers_to(king) & board.pieces(them);
+  if (checkers.more_than_one()) return false;
+  const Bitboard check_mask =
+      checkers.empty() ? ALL_SQUARES : checkers | BETWEEN[king.value()][checkers.lsb().value()];
+
+  if (move.type() == Move::EN_PASSANT) {
+    const std::optional<Square> ep = board.en_passant_square();
+    return kind == Piece::P && ep == to && en_passant_capturers(board, us, to).test(from) &&
+           (check_mask.test(to) || check_mask.test(en_passant_victim(us, to))) &&
+           en_passant_keeps_king_safe(board, us, king, from, to);
+  }
+
+  Bitboard reachable;
+  if (kind == Piece::P) {
+    const bool white = us == Piece::WHITE;
+    const Bitboard promotion_rank = white ? RANK_8 : RANK_1;
+    if ((move.type() == Move::PROMOTION) != promotion_rank.test(to)) return false;
+    Bitboard pawn;
+    pawn.set(from);
+    const Bitboard single = forward(pawn, us) & ~occupied;
+    const Bitboard double_push = forward(single & (white ? RANK_3 : RANK_6), us) & ~occupied;
+    const Bitboard attacks = white ? WHITE_PAWN_ATTACKS[from.value()] : BLACK_PAWN_ATTACKS[from.value()];
+    reachable = single | double_push | (attacks & board.pieces(them));
+  } else {
+    if (move.type() != Move::NORMAL) return false;
+    if (kind == Piece::N) reachable = KNIGHT_ATTACKS[from.value()];
+    if (kind == Piece::B || kind == Piece::Q) reachable |= bishop_attacks(from, occupied);
+    if (kind == Piece::R || kind == Piece::Q) reachable |= rook_attacks(from, occupied);
+  }
+  if (!(reachable & check_mask).test(to)) return false;
+
+  return !pinned_pieces(board, us, king).test(from) || LINE[king.value()][from.value()].test(to);
+}
+
+}  // namespace MoveGen
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chess_engine/movegen.hpp>
+#include <chess_engine/perft.hpp>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+PerftHashTable::PerftHashTable(std::size_t megabytes) {
+  const std::size_t entries = std::max<std::size_t>(1, (megabytes << 20) / sizeof(Entry));
+  const std::size_t size = std::bit_floor(entries);
+  m_entries = std::make_unique<Entry[]>(size);
+  m_mask = size - 1;
+}
+
+void PerftHashTable::clear() {
+  for (std::size_t i = 0; i < size(); ++i) {
+    m_entries[i].check.store(0, std::memory_order_relaxed);
+    m_entries[i].data.store(0, std::memory_order_relaxed);
+  }
+}
+
+namespace {
+
+/**
+ * Subtree to count: the position after a root move (and possibly a reply), credited to that root move.
+ */
+struct Task {
+  std::size_t root;
+  Board board;
+  int depth;
+};
+
+/**
+ * Task deque of one worker. The owner works from the back, thieves take from the front,
+ * so they take the tasks the owner would reach last.
+ */
+class TaskQueue {
+ private:
+  std::mutex m_mutex;
+  std::deque<Task> m_tasks;
+
+ public:
+  void push(Task task) {
+    std::lock_guard lock(m_mutex);
+    m_tasks.push_back(std::move(task));
+  }
+
+  std::optional<Task> pop() {
+    std::lock_guard lock(m_mutex);
+    if (m_tasks.empty()) return std::nullopt;
+    Task task = std::move(m_tasks.back());
+    m_tasks.pop_back();
+    return task;
+  }
+
+  std::optional<Task> steal() {
+    std::lock_guard lock(m_mutex);
+    if (m_tasks.empty()) return std::nullopt;
+    Task task = std::move(m_tasks.front());
+    m_tasks.pop_front();
+    return task;
+  }
+};
+
+uint64_t count(Board& board, int depth, PerftHashTable* table, Perft::HashStats& stats) {
+  return table ? Perft::perft(board, depth, *table, stats) : Perft::perft(board, depth);
+}
+
+}  // namespace
+
+namespace Perft {
+
+uint64_t perft(Board& board, int depth) {
+  if (depth == 0) return 1;
+
+  MoveList moves;
+  MoveGen::generate_legal(board, moves);
+  if (depth == 1) return moves.size();
+
+  uint64_t nodes = 0;
+  for (const Move move : moves) {
+    const Board::UndoInfo undo = board.make_move(move);
+    nodes += perft(board, depth - 1);
+    board.unmake_move(move, undo);
+  }
+  return nodes;
+}
+
+std::vector<DivideEntry> divide(Board& board, int depth) {
+  MoveList moves;
+  MoveGen::generate_legal(board, moves);
+
+  std::vector<DivideEntry> entries;
+  entries.reserve(moves.size());
+  for (const Move move : moves) {
+    const Board::UndoInfo undo = board.make_move(move);
+    entries.push_back({move, perft(board, depth - 1)});
+    board.unmake_move(move, undo);
+  }
+  return entries;
+}
+
+uint64_t perft(Board& board, int depth, PerftHashTable& table, HashStats& stats) {
+  if (depth <= 1) return perft(board, depth);
+
+  uint64_t nodes = 0;
+  ++stats.probes;
+  if (table.probe(board.hash(), depth, nodes)) {
+    ++stats.hits;
+    return nodes;
+  }
+
+  MoveList moves;
+  MoveGen::generate_legal(board, moves);
+  for (const Move move : moves) {
+    const Board::UndoInfo undo = board.make_move(move);
+    nodes += perft(board, depth - 1, table, stats);
+    board.unmake_move(move, undo);
+  }
+  table.store(board.hash(), depth, nodes);
+  return nodes;
+}
+
+std::vector<DivideEntry> divide(const Board& board, int depth, unsigned threads, PerftHashTable* table,
+                                HashStats* stats) {
+  threads = std::max(threads, 1u);
+
+  MoveList moves;
+  MoveGen::generate_legal(board, moves);
+
+  // Split the tree two plies deep when there is enough work below, to get many more tasks than threads
+  std::vector<TaskQueue> queues(threads);
+  std::size_t dealt = 0;
+  for (std::size_t root = 0; root < moves.size(); ++root) {
+    Board child = board;
+    child.make_move(moves[root]);
+    if (depth < 3) {
+      queues[dealt++ % threads].push({root, child, depth - 1});
+      continue;
+    }
+    MoveList replies;
+    MoveGen::generate_legal(child, replies);
+    for (const Move reply : replies) {
+      Board grandchild = child;
+      grandchild.make_move(reply);
+      queues[dealt++ % threads].push({root, grandchild, depth - 2});
+    }
+  }
+
+  // Tasks are never created while workers run, so a worker finding every deque empty is done
+  std::vector<std::atomic<uint64_t>> counts(moves.size());
+  std::mutex stats_mutex;
+  auto work = [&](unsigned id) {
+    HashStats local;
+    for (;;) {
+      std::optional<Task> task = queues[id].pop();
+      for (unsigned k = 1; !task && k < threads; ++k) {
+        task = queues[(id + k) % threads].steal();
+      }
+      if (!task) break;
+      counts[task->root].fetch_add(count(task->board, task->depth, table, local), std::memory_order_relaxed);
+    }
+    if (stats) {
+      std::lock_guard lock(stats_mutex);
+      stats->probes += local.probes;
+      stats->hits += local.hits;
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (unsigned id = 1; id < threads; ++id) workers.emplace_back(work, id);
+  work(0);
+  for (std::thread& worker : workers) worker.join();
+
+  std::vector<DivideEntry> entries;
+  entries.reserve(moves.size());
+  for (std::size_t root = 0; root < moves.size(); ++root) {
+    entries.push_back({moves[root], counts[root].load(std::memory_order_relaxed)});
+  }
+  return entries;
+}
+
+}  // namespace Perft
@@ -0,0 +1,414 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chess_engine/move_ordering.hpp>
+#include <chess_engine/movegen.hpp>
+#include <chess_engine/search.hpp>
+#include <chess_engine/see.hpp>
+#include <memory>
+#include <span>
+#include <thread>
+
+namespace {
+
+static_assert(Search::MAX_PLY <= History::MAX_PLY, "every ply needs its killer moves");
+
+/**
+ * Centralization of each square: 0 on the corners up to 6 on the four center squares. Symmetric, so it
+ * serves both colors without mirroring.
+ */
+constexpr std::array<int, 64> CENTER = [] {
+  std::array<int, 64> center{};
+  for (int sq = 0; sq < 64; ++sq) {
+    const int file = sq % 8;
+    const int rank = sq / 8;
+    center[sq] = std::min(file, 7 - file) + std::min(rank, 7 - rank);
+  }
+  return center;
+}();
+
+/** Centralization bonus per piece kind (P, N, B, R, Q, K), in centipawns per CENTER unit. */
+constexpr std::array<int, 6> CENTER_WEIGHTS = {3, 5, 3, 0, 1, 0};
+
+/**
+ * Mate scores count plies from the root, but a table entry may be reached at another ply: they are stored
+ * relative to the node and converted back when probed.
+ */
+int score_to_table(int score, int ply) {
+  if (score >= Search::VALUE_MATE - Search::MAX_PLY) return score + ply;
+  if (score <= -(Search::VALUE_MATE - Search::MAX_PLY)) return score - ply;
+  return score;
+}
+
+int score_from_table(int score, int ply) {
+  if (score >= Search::VALUE_MATE - Search::MAX_PLY) return score - ply;
+  if (score <= -(Search::VALUE_MATE - Search::MAX_PLY)) return score + ply;
+  return score;
+}
+
+/**
+ * Depth skipping of the helper threads: helper i (from 1) searches depth d unless
+ * ((d + SKIP_PHASE[j]) / SKIP_SIZE[j]) is odd, with j = (i - 1) % 20. Helpers thereby run ahead of the main
+ * thread on different depths, filling the shared table with results the others will probe.
+ */
+constexpr std::array<int, 20> SKIP_SIZE = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+constexpr std::array<int, 20> SKIP_PHASE = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+bool skips_depth(unsigned thread, int depth) {
+  if (thread == 0) return false;
+  const std::size_t j = (thread - 1) % SKIP_SIZE.size();
+  return ((depth + SKIP_PHASE[j]) / SKIP_SIZE[j]) % 2 != 0;
+}
+
+/** Node counter of one thread, alone on its cache line so that counting does not bounce lines between cores. */
+struct alignas(64) NodeCounter {
+  std::atomic<uint64_t> nodes{0};
+};
+
+/**
+ * State shared by the threads of one search: limits, transposition table, clock, stop flag and the node
+ * counters, which only their own thread writes.
+ */
+struct SharedState {
+  using Clock = std::chrono::steady_clock;
+
+  const Search::Limits& limits;
+  TranspositionTable* table;
+  Clock::time_point start = Clock::now();
+  std::atomic<bool> stop{false};
+  std::vector<NodeCounter> counters;
+
+  SharedState(const Search::Limits& limits, TranspositionTable* table, unsigned threads)
+      : limits(limits), table(table), counters(threads) {}
+
+  uint64_t total_nodes() const {
+    uint64_t total = 0;
+    for (const NodeCounter& counter : counters) total += counter.nodes.load(std::memory_order_relaxed);
+    return total;
+  }
+
+  std::chrono::milliseconds elapsed() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+  }
+};
+
+/**
+ * Last iteration completed by a thread.
+ */
+struct Iteration {
+  int depth = 0;
+  int score = 0;
+  std::vector<Move> pv;
+};
+
+/**
+ * One search thread: the board walked with make/unmake, the principal variation table, the move ordering
+ * History and statistics, all private to the thread. Thread 0 is the main thread, which reports progress.
+ */
+class Searcher {
+ private:
+  /** Nodes between two clock reads. */
+  static constexpr uint64_t CLOCK_INTERVAL = 2048;
+
+  /** Nodes between two reads of the other threads' counters, for the node limit of a multithreaded search. */
+  static constexpr uint64_t NODES_POLL_INTERVAL = 1024;
+
+  Board m_board;
+  SharedState& m_shared;
+  const unsigned m_thread;
+  NodeCounter& m_counter;
+  uint64_t m_nodes = 0;
+  bool m_stopped = false;
+  int m_root_depth = 0;
+
+  /** Keys of the game history and of the positions on the searched path, the current position last. */
+  std::vector<uint64_t> m_keys;
+
+  /** Triangular PV table: m_pv[ply] holds the best line found from `ply`, m_pv_length[ply] its end. */
+  std::array<std::array<Move, Search::MAX_PLY + 1>, Search::MAX_PLY + 1> m_pv;
+  std::array<int, Search::MAX_PLY + 1> m_pv_length;
+
+  /** PV of the previous iteration, tried first while the current path still follows it. */
+  std::vector<Move> m_previous_pv;
+  bool m_follow_pv = false;
+
+  History m_history;
+  Search::Stats m_stats;
+
+  /** Piece and destination of the move played at each ply of the current path. */
+  std::array<History::PieceTo, Search::MAX_PLY + 1> m_played;
+
+  Iteration m_completed;
+
+ public:
+  Searcher(const Board& board, SharedState& shared, std::span<const uint64_t> history, unsigned thread)
+      : m_board(board),
+        m_shared(shared),
+        m_thread(thread),
+        m_counter(shared.counters[thread]),
+        m_keys(history.begin(), history.end()) {
+    m_keys.reserve(m_keys.size() + Search::MAX_PLY + 1);
+    m_keys.push_back(board.hash());
+  }
+
+  /** Runs iterative deepening until the depth limit or the stop flag; the main thread reports each iteration. */
+  void run(const std::function<void(const Search::Info&)>& on_info);
+
+  const Iteration& completed() const { return m_completed; }
+
+  const Search::Stats& stats() const { return m_stats; }
+
+ private:
+  /**
+   * Counts a node and checks for the end of the search. Any thread reaching a limit or seeing the caller's stop
+   * request raises the shared stop flag, and every thread stops once it sees it, except the main thread during
+   * its first iteration.
+   */
+  bool visit() {
+    m_counter.nodes.store(++m_nodes, std::memory_order_relaxed);
+    if (m_stopped) return true;
+    if (m_thread == 0 && m_root_depth == 1) return false;
+
+    const Search::Limits& limits = m_shared.limits;
+    const uint64_t poll = m_shared.counters.size() == 1 ? 1 : NODES_POLL_INTERVAL;
+    if ((limits.nodes != 0 && m_nodes % poll == 0 && m_shared.total_nodes() >= limits.nodes) ||
+        (limits.movetime.count() != 0 && m_nodes % CLOCK_INTERVAL == 0 && m_shared.elapsed() >= limits.movetime) ||
+        (limits.stop && m_nodes % CLOCK_INTERVAL == 0 && limits.stop->load(std::memory_order_relaxed))) {
+      m_shared.stop.store(true, std::memory_order_relaxed);
+    }
+    m_stopped = m_shared.stop.load(std::memory_order_relaxed);
+    return m_stopped;
+  }
+
+  /** Fifty-move rule, or the current position already occurred since the last irreversible move. */
+  bool is_draw() const {
+    const int reversible = m_board.halfmove_clock();
+    if (reversible >= 100) return true;
+    const int last = static_cast<int>(m_keys.size()) - 1;
+    for (int i = last - 4; i >= std::max(0, last - reversible); i -= 2) {
+      if (m_keys[i] == m_keys[last]) return true;
+    }
+    return false;
+  }
+
+  Board::UndoInfo make(Move move) {
+    const Board::UndoInfo undo = m_board.make_move(move);
+    if (m_shared.table) m_shared.table->prefetch(m_board.hash());
+    m_keys.push_back(m_board.hash());
+    return undo;
+  }
+
+  void unmake(Move move, const Board::UndoInfo& undo) {
+    m_keys.pop_back();
+    m_board.unmake_move(move, undo);
+  }
+
+  void update_pv(int ply, Move move) {
+    m_pv[ply][ply] = move;
+    for (int i = ply + 1; i < m_pv_length[ply + 1]; ++i) m_pv[ply][i] = m_pv[ply + 1][i];
+    m_pv_length[ply] = m_pv_length[ply + 1];
+  }
+
+  /** Returns the move of the previous PV at this ply while the path follows it, the null move otherwise. */
+  Move pv_move(int ply) {
+    if (!m_follow_pv) return Move();
+    m_follow_pv = ply < static_cast<int>(m_previous_pv.size()) && MoveGen::is_legal(m_board, m_previous_pv[ply]);
+    return m_follow_pv ? m_previous_pv[ply] : Move();
+  }
+
+  /** Counts a beta cutoff caused by the move at `index` among the moves searched. */
+  void record_cutoff(int index) {
+    ++m_stats.cutoffs;
+    m_stats.first_move_cutoffs += index == 0;
+    m_stats.cutoff_index_sum += static_cast<uint64_t>(index);
+  }
+
+  int negamax(int depth, int ply, int alpha, int beta);
+  int quiescence(int ply, int alpha, int beta);
+};
+
+void Searcher::run(const std::function<void(const Search::Info&)>& on_info) {
+  const Search::Limits& limits = m_shared.limits;
+  const int max_depth = limits.depth > 0 ? std::min(limits.depth, Search::MAX_PLY) : Search::MAX_PLY;
+  for (m_root_depth = 1; m_root_depth <= max_depth; ++m_root_depth) {
+    if (skips_depth(m_thread, m_root_depth)) continue;
+
+    m_follow_pv = true;
+    const int score = negamax(m_root_depth, 0, -Search::VALUE_INFINITE, Search::VALUE_INFINITE);
+    if (m_stopped) break;
+
+    m_previous_pv.assign(m_pv[0].begin(), m_pv[0].begin() + m_pv_length[0]);
+    m_completed = {m_root_depth, score, m_previous_pv};
+    if (on_info) {
+      const int hashfull = m_shared.table ? m_shared.table->hashfull() : 0;
+      on_info({m_root_depth, score, m_shared.total_nodes(), m_shared.elapsed(), m_previous_pv, hashfull, m_stats});
+    }
+  }
+}
+
+int Searcher::negamax(int depth, int ply, int alpha, int beta) {
+  if (depth <= 0) return quiescence(ply, alpha, beta);
+
+  m_pv_length[ply] = ply;
+  if (visit()) return 0;
+  if (ply > 0 && is_draw()) return 0;
+  if (ply >= Search::MAX_PLY) return Search::evaluate(m_board);
+
+  const bool in_check = m_board.in_check();
+  if (in_check) ++depth;  // check extension: a forced sequence is not cut off at the horizon
+
+  // A deep enough stored result settles the node, unless its bound says nothing about this window
+  TranspositionTable* table = m_shared.table;
+  TranspositionTable::Data stored{};
+  const bool hit = table && table->probe(m_board.hash(), stored);
+  if (hit && ply > 0 && stored.depth >= depth) {
+    const int score = score_from_table(stored.score, ply);
+    if (stored.bound == TranspositionTable::EXACT || (stored.bound == TranspositionTable::LOWER && score >= beta) ||
+        (stored.bound == TranspositionTable::UPPER && score <= alpha)) {
+      return score;
+    }
+  }
+
+  // Moves are generated lazily: the hash move first, quiet moves only if the captures do not cut off
+  const int original_alpha = alpha;
+  const Move followed = pv_move(ply);
+  const History::PieceTo previous = ply > 0 ? m_played[ply - 1] : History::PieceTo{};
+  MovePicker picker(m_board, followed.is_null() && hit ? stored.move : followed, &m_history, ply, previous);
+  int best = -Search::VALUE_INFINITE;
+  Move best_move;
+  MoveList quiets;  // quiet moves searched without a cutoff
+  int index = 0;
+  for (Move move = picker.next(); !move.is_null(); move = picker.next(), ++index) {
+    const bool quiet = !MoveOrdering::is_tactical(m_board, move);
+    m_played[ply] = History::piece_to(m_board, move);
+    const Board::UndoInfo undo = make(move);
+    const int score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+    unmake(move, undo);
+    m_follow_pv = false;
+    if (m_stopped) return 0;
+
+    if (score > best) {
+      best = score;
+      if (score > alpha) {
+        alpha = score;
+        best_move = move;
+        update_pv(ply, move);
+        if (alpha >= beta) {
+          record_cutoff(index);
+          if (quiet) m_history.update(m_board, move, std::span(quiets.begin(), quiets.end()), depth, ply, previous);
+          break;
+        }
+      }
+    }
+    if (quiet) quiets.push_back(move);
+  }
+  if (best == -Search::VALUE_INFINITE) return in_check ? -Search::VALUE_MATE + ply : 0;  // no legal move
+
+  if (table) {
+    const TranspositionTable::Bound bound = best >= beta             ? TranspositionTable::LOWER
+                                            : best > original_alpha ? TranspositionTable::EXACT
+                                                                    : TranspositionTable::UPPER;
+    table->store(m_board.hash(), best_move, score_to_table(best, ply), depth, bound);
+  }
+  return best;
+}
+
+int Searcher::quiescence(int ply, int alpha, int beta) {
+  m_pv_length[ply] = ply;
+  if (visit()) return 0;
+  if (ply >= Search::MAX_PLY) return Search::evaluate(m_board);
+
+  // In check every evasion is searched, there is no standing pat
+  const bool in_check = m_board.in_check();
+  int best = -Search::VALUE_INFINITE;
+  if (!in_check) {
+    best = Search::evaluate(m_board);
+    if (best >= beta) return best;
+    alpha = std::max(alpha, best);
+  }
+
+  // Out of check only captures are generated, so a stalemate goes unnoticed and scores as standing pat
+  MovePicker picker = in_check ? MovePicker(m_board, Move(), nullptr, ply, {}) : MovePicker(m_board);
+  for (Move move = picker.next(); !move.is_null(); move = picker.next()) {
+    const Board::UndoInfo undo = make(move);
+    const int score = -quiescence(ply + 1, -beta, -alpha);
+    unmake(move, undo);
+    if (m_stopped) return 0;
+
+    if (score > best) {
+      best = score;
+      if (score > alpha) {
+        alpha = score;
+        update_pv(ply, move);
+        if (alpha >= beta) break;
+      }
+    }
+  }
+  if (best == -Search::VALUE_INFINITE) return -Search::VALUE_MATE + ply;  // in check without evasion
+  return best;
+}
+
+}  // namespace
+
+namespace Search {
+
+int evaluate(const Board& board) {
+  int score = 0;
+  for (int type = Piece::P; type <= Piece::k; ++type) {
+    const Piece piece(static_cast<Piece::Type>(type));
+    if (piece.kind() == Piece::K) continue;
+    int value = 0;
+    for (const Square sq : board.pieces(piece.type())) {
+      value += See::PIECE_VALUES[piece.kind()] + CENTER_WEIGHTS[piece.kind()] * CENTER[sq.value()];
+    }
+    score += piece.color() == Piece::WHITE ? value : -value;
+  }
+  return board.is_white_turn() ? score : -score;
+}
+
+Result search(const Board& board, const Limits& limits, const std::function<void(const Info&)>& on_info,
+              std::span<const uint64_t> history, TranspositionTable* table, unsigned threads) {
+  Result result;
+  MoveList root_moves;
+  MoveGen::generate_legal(board, root_moves);
+  if (root_moves.empty()) {
+    result.score = board.in_check() ? -VALUE_MATE : 0;
+    return result;
+  }
+  if (table) table->new_search();
+
+  threads = std::clamp(threads, 1u, MAX_THREADS);
+  SharedState shared(limits, table, threads);
+  std::vector<std::unique_ptr<Searcher>> searchers;
+  for (unsigned id = 0; id < threads; ++id) searchers.push_back(std::make_unique<Searcher>(board, shared, history, id));
+
+  std::vector<std::thread> helpers;
+  helpers.reserve(threads - 1);
+  for (unsigned id = 1; id < threads; ++id) helpers.emplace_back([&searchers, id] { searchers[id]->run({}); });
+  searchers[0]->run(on_info);
+  shared.stop.store(true, std::memory_order_relaxed);
+  for (std::thread& helper : helpers) helper.join();
+
+  // The deepest completed iteration wins, the main thread on ties
+  const Iteration* best = &searchers[0]->completed();
+  for (const auto& searcher : searchers) {
+    if (searcher->completed().depth > best->depth) best = &searcher->completed();
+  }
+  result.nodes = shared.total_nodes();
+  for (const auto& searcher : searchers) result.stats += searcher->stats();
+  if (best->pv.empty()) {
+    result.best_move = root_moves[0];
+    return result;
+  }
+  if (best != &searchers[0]->completed() && on_info) {
+    on_info({best->depth, best->score, result.nodes, shared.elapsed(), best->pv, table ? table->hashfull() : 0,
+             searchers[0]->stats()});
+  }
+  result.best_move = best->pv.front();
+  result.score = best->score;
+  result.depth = best->depth;
+  result.pv = best->pv;
+  return result;
+}
+
+}  // namespace Search
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <chess_engine/attacks/sliders.hpp>
+#include <chess_engine/see.hpp>
+
+namespace {
+
+/**
+ * Starting point of an exchange: what the move wins before any recapture and what it leaves on the square.
+ */
+struct Exchange {
+  int gain;            ///< Value of the captured piece, plus the promotion gain
+  int victim;          ///< Value of the piece standing on the destination square after the move
+  Bitboard occupancy;  ///< Occupancy after the move (the moving piece and any captured pawn removed)
+  Bitboard attackers;  ///< Remaining attackers of the destination square, both colors
+};
+
+Exchange start_exchange(const Board& board, Move move) {
+  const Square from = move.from();
+  const Square to = move.to();
+  const Piece::Color us = board.side_to_move();
+
+  Exchange exchange;
+  exchange.gain = See::value(board.get_piece(to).type());
+  exchange.victim = See::value(board.get_piece(from).type());
+  exchange.occupancy = board.occupied() ^ Bitboard(1ULL << from.value());
+
+  if (move.type() == Move::EN_PASSANT) {
+    const Square victim = Square::unchecked(to.file(), from.rank());
+    exchange.gain = See::PIECE_VALUES[Piece::P];
+    exchange.occupancy ^= Bitboard(1ULL << victim.value());
+  } else if (move.type() == Move::PROMOTION) {
+    exchange.victim = See::value(move.promotion_type(us));
+    exchange.gain += exchange.victim - See::PIECE_VALUES[Piece::P];
+  }
+
+  exchange.attackers = board.attackers_to(to, exchange.occupancy) & exchange.occupancy;
+  return exchange;
+}
+
+/**
+ * Least valuable piece kind among `attackers` (pieces of one color), or NO_PIECE if there is none.
+ */
+Piece::Type least_valuable(const Board& board, Bitboard attackers, Piece::Color color, Bitboard& piece) {
+  for (int kind = Piece::P; kind <= Piece::K; ++kind) {
+    piece = attackers & board.pieces(Piece::make_type(color, static_cast<Piece::Type>(kind)));
+    if (!piece.empty()) return static_cast<Piece::Type>(kind);
+  }
+  return Piece::NO_PIECE;
+}
+
+/**
+ * Removes a capturing piece from the occupancy and adds the sliders it uncovers behind it.
+ */
+void remove_attacker(const Board& board, Square to, Piece::Type kind, Bitboard piece, Exchange& exchange) {
+  using namespace Attacks;
+  exchange.occupancy ^= Bitboard(1ULL << piece.lsb().value());
+
+  // Only a piece standing on a line through the square can uncover a slider on that line
+  const Bitboard queens = board.pieces(Piece::Q) | board.pieces(Piece::q);
+  if (kind == Piece::P || kind == Piece::B || kind == Piece::Q) {
+    const Bitboard bishops = board.pieces(Piece::B) | board.pieces(Piece::b) | queens;
+    exchange.attackers |= bishop_attacks(to, exchange.occupancy) & bishops;
+  }
+  if (kind == Piece::R || kind == Piece::Q) {
+    const Bitboard rooks = board.pieces(Piece::R) | board.pieces(Piece::r) | queens;
+    exchange.attackers |= rook_attacks(to, exchange.occupancy) & rooks;
+  }
+  exchange.attackers &= exchange.occupancy;
+}
+
+constexpr Piece::Color opponent(Piece::Color color) { return color == Piece::WHITE ? Piece::BLACK : Piece::WHITE; }
+
+}  // namespace
+
+namespace See {
+
+int see(const Board& board, Move move) {
+  if (move.type() == Move::CASTLING) return 0;
+
+  const Square to = move.to();
+  Exchange exchange = start_exchange(board, move);
+
+  // gains[d]: balance for the side making the d-th capture if the exchange stopped right after it
+  // (each capture takes a piece off the board, so at most 63 captures, even in positions no game can reach)
+  int gains[64];
+  gains[0] = exchange.gain;
+  int victim = exchange.victim;
+  int depth = 0;
+
+  Piece::Color side = board.side_to_move();
+  while (true) {
+    side = opponent(side);
+    Bitboard piece;
+    const Piece::Type kind = least_valuable(board, exchange.attackers & board.pieces(side), side, piece);
+    if (kind == Piece::NO_PIECE) break;
+
+    ++depth;
+    gains[depth] = victim - gains[depth - 1];
+    victim = PIECE_VALUES[kind];
+    remove_attacker(board, to, kind, piece, exchange);
+  }
+
+  // Each side picks the better of stopping before its capture or capturing and letting the exchange go on
+  while (depth > 0) {
+    gains[depth - 1] = -std::max(-gains[depth - 1], gains[depth]);
+    --depth;
+  }
+  return gains[0];
+}
+
+bool see_ge(const Board& board, Move move, int threshold) {
+  if (move.type() == Move::CASTLING) return threshold <= 0;
+
+  const Square to = move.to();
+  Exchange exchange = start_exchange(board, move);
+
+  // `swap` is what the side to capture next must win for the outcome to flip, relative to the threshold
+  int swap = exchange.gain - threshold;
+  if (swap < 0) return false;  // even without recapture, the threshold is not reached
+  swap = exchange.victim - swap;
+  if (swap <= 0) return true;  // even losing the moved piece, the threshold is reached
+
+  // `result` is true while the exchange, stopped now, reaches the threshold
+  bool result = true;
+  Piece::Color side = board.side_to_move();
+  while (true) {
+    side = opponent(side);
+    Bitboard piece;
+    const Piece::Type kind = least_valuable(board, exchange.attackers & board.pieces(side), side, piece);
+    if (kind == Piece::NO_PIECE) break;
+
+    // The king may only capture if the other side has no attacker left, otherwise the capture is illegal
+    if (kind == Piece::K) {
+      return (exchange.attackers & board.pieces(opponent(side))).empty() ? !result : result;
+    }
+
+    result = !result;
+    swap = PIECE_VALUES[kind] - swap;
+    if (swap < static_cast<int>(result)) break;
+
+    remove_attacker(board, to, kind, piece, exchange);
+  }
+  return result;
+}
+
+}  // namespace See
@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <cerrno>
+#include <chess_engine/transposition_table.hpp>
+#include <chrono>
+#include <limits>
+#include <new>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CHESS_ENGINE_POSIX_SHM
+#endif
+
+namespace {
+
+std::size_t clamp_megabytes(std::size_t megabytes) {
+  return std::clamp<std::size_t>(megabytes, 1, TranspositionTable::MAX_MB);
+}
+
+#ifdef CHESS_ENGINE_POSIX_SHM
+std::unexpected<std::error_code> last_error() {
+  return std::unexpected(std::error_code(errno, std::system_category()));
+}
+
+/** How long a process attaching to a segment waits for its creator to set it up. */
+constexpr std::chrono::seconds SHARED_SETUP_TIMEOUT{1};
+
+/** Polls a condition until it holds or SHARED_SETUP_TIMEOUT elapses, returns its last value. */
+template <typename Condition>
+bool wait_for_setup(Condition condition) {
+  const auto deadline = std::chrono::steady_clock::now() + SHARED_SETUP_TIMEOUT;
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() >= deadline) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+#endif
+
+}  // namespace
+
+TranspositionTable::TranspositionTable(std::size_t megabytes) {
+  if (!resize(megabytes)) throw std::bad_alloc();
+}
+
+TranspositionTable::~TranspositionTable() { release(); }
+
+void TranspositionTable::release() {
+  if (!m_clusters) return;
+#ifdef CHESS_ENGINE_POSIX_SHM
+  if (m_header) munmap(m_header, m_mapped_bytes);
+#endif
+  if (!m_header) delete[] m_clusters;
+  m_clusters = nullptr;
+  m_cluster_count = 0;
+  m_header = nullptr;
+  m_mapped_bytes = 0;
+  m_shared_name.clear();
+  m_generation = &m_private_generation;
+}
+
+std::expected<void, std::error_code> TranspositionTable::resize(std::size_t megabytes) {
+  // The old table is only released once the new one is allocated, so that a failure leaves it usable
+  const std::size_t count = std::max<std::size_t>(1, (clamp_megabytes(megabytes) << 20) / sizeof(Cluster));
+  Cluster* clusters = new (std::nothrow) Cluster[count]();
+  if (!clusters) return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+
+  release();
+  m_cluster_count = count;
+  m_clusters = clusters;
+  m_private_generation.store(0, std::memory_order_relaxed);
+  return {};
+}
+
+std::expected<void, std::error_code> TranspositionTable::attach_shared(std::string_view name, std::size_t megabytes) {
+#ifdef CHESS_ENGINE_POSIX_SHM
+  const std::string shm_name(name);
+  bool created = true;
+  int fd = shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0 && errno == EEXIST) {
+    created = false;
+    fd = shm_open(shm_name.c_str(), O_RDWR, 0);
+  }
+  if (fd < 0) return last_error();
+
+  // The creator sizes the segment (ftruncate zero-fills it): the header, then the clusters of the budget
+  std::size_t bytes = sizeof(SharedHeader) + (clamp_megabytes(megabytes) << 20) / sizeof(Cluster) * sizeof(Cluster);
+  if (created && ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+    const auto error = last_error();
+    close(fd);
+    shm_unlink(shm_name.c_str());
+    return error;
+  }
+  if (!created) {
+    // The others take the size it was given, once the creator has set it
+    struct stat status{};
+    const bool sized = wait_for_setup([&] {
+      return fstat(fd, &status) == 0 && static_cast<std::size_t>(status.st_size) > sizeof(SharedHeader);
+    });
+    if (!sized) {
+      close(fd);
+      return std::unexpected(std::make_error_code(std::errc::resource_unavailable_try_again));
+    }
+    bytes = static_cast<std::size_t>(status.st_size);
+  }
+
+  void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const auto map_error = last_error();
+  close(fd);
+  if (memory == MAP_FAILED) {
+    if (created) shm_unlink(shm_name.c_str());
+    return map_error;
+  }
+
+  SharedHeader* header = nullptr;
+  Cluster* clusters = nullptr;
+  const std::size_t count = (bytes - sizeof(SharedHeader)) / sizeof(Cluster);
+  if (created) {
+    // Construct the (all-zero, hence empty) header and entries, then publish them
+    header = new (memory) SharedHeader;
+    clusters = reinterpret_cast<Cluster*>(header + 1);
+    for (std::size_t i = 0; i < count; ++i) new (clusters + i) Cluster;
+    header->initialized.store(SHARED_MAGIC, std::memory_order_release);
+  } else {
+    // Until the creator publishes them, only the zero-filled flag may be read
+    header = std::launder(static_cast<SharedHeader*>(memory));
+    if (!wait_for_setup([&] { return header->initialized.load(std::memory_order_acquire) == SHARED_MAGIC; })) {
+      munmap(memory, bytes);
+      return std::unexpected(std::make_error_code(std::errc::resource_unavailable_try_again));
+    }
+    clusters = std::launder(reinterpret_cast<Cluster*>(header + 1));
+  }
+
+  release();
+  m_header = header;
+  m_clusters = clusters;
+  m_cluster_count = count;
+  m_generation = &header->generation;
+  m_mapped_bytes = bytes;
+  m_shared_name = shm_name;
+  return {};
+#else
+  (void)name;
+  (void)megabytes;
+  return std::unexpected(std::make_error_code(std::errc::not_supported));
+#endif
+}
+
+std::expected<void, std::error_code> TranspositionTable::remove_shared(std::string_view name) {
+#ifdef CHESS_ENGINE_POSIX_SHM
+  if (shm_unlink(std::string(name).c_str()) != 0) return last_error();
+  return {};
+#else
+  (void)name;
+  return std::unexpected(std::make_error_code(std::errc::not_supported));
+#endif
+}
+
+void TranspositionTable::clear() {
+  for (std::size_t i = 0; i < m_cluster_count; ++i) {
+    for (Entry& entry : m_clusters[i].entries) {
+      entry.check.store(0, std::memory_order_relaxed);
+      entry.data.store(0, std::memory_order_relaxed);
+    }
+  }
+  m_generation->store(0, std::memory_order_relaxed);
+}
+
+bool TranspositionTable::probe(uint64_t key, Data& data) const {
+  for (const Entry& entry : cluster(key).entries) {
+    const uint64_t word = entry.data.load(std::memory_order_relaxed);
+    const uint64_t check = entry.check.load(std::memory_order_relaxed);
+    if ((check ^ word) != key || bound_of(word) == NONE) continue;
+    data = {move_of(word), score_of(word), depth_of(word), bound_of(word)};
+    return true;
+  }
+  return false;
+}
+
+void TranspositionTable::store(uint64_t key, Move move, int score, int depth, Bound bound) {
+  const uint8_t current_age = age();
+  Entry* victim = nullptr;
+  int victim_worth = std::numeric_limits<int>::max();
+  for (Entry& entry : cluster(key).entries) {
+    const uint64_t word = entry.data.load(std::memory_order_relaxed);
+    const uint64_t check = entry.check.load(std::memory_order_relaxed);
+    if ((check ^ word) == key && bound_of(word) != NONE) {
+      // Same position: keep a much deeper result of this search over a mere bound
+      if (bound != EXACT && age_of(word) == current_age && depth_of(word) > depth + 3) return;
+      if (move.is_null()) move = move_of(word);
+      victim = &entry;
+      break;
+    }
+    // Empty entries go first, then shallow ones, an entry losing 8 plies of worth per search it is old
+    const int worth = bound_of(word) == NONE ? -1000 : depth_of(word) - 8 * ((current_age - age_of(word)) & AGE_MASK);
+    if (worth < victim_worth) {
+      victim_worth = worth;
+      victim = &entry;
+    }
+  }
+
+  const uint64_t data = pack(move, score, depth, bound, current_age);
+  victim->check.store(key ^ data, std::memory_order_relaxed);
+  victim->data.store(data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const {
+  const std::size_t samples = std::min<std::size_t>(m_cluster_count, 250);
+  const uint8_t current_age = age();
+  int used = 0;
+  for (std::size_t i = 0; i < samples; ++i) {
+    for (const Entry& entry : m_clusters[i].entries) {
+      const uint64_t word = entry.data.load(std::memory_order_relaxed);
+      used += bound_of(word) != NONE && age_of(word) == current_age;
+    }
+  }
+  return static_cast<int>(used * 1000 / (samples * CLUSTER_SIZE));
+}
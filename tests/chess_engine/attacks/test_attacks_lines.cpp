@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <chess_engine/attacks/lines.hpp>
+#include <chess_engine/bitboard.hpp>
+#include <chess_engine/square.hpp>
+#include <cstdint>
+
+using namespace Attacks;
+
+namespace {
+
+constexpr int DIRECTIONS[8][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}, {1, 1}, {-1, -1}, {1, -1}, {-1, 1}};
+
+bool on_board(int file, int rank) { return file >= 0 && file < 8 && rank >= 0 && rank < 8; }
+
+/**
+ * @brief Reference implementation: walks from a in each direction, collecting squares until b is reached.
+ */
+uint64_t walk_between(int a, int b) {
+  for (const auto& [df, dr] : DIRECTIONS) {
+    uint64_t squares = 0ULL;
+    for (int f = a % 8 + df, r = a / 8 + dr; on_board(f, r); f += df, r += dr) {
+      if (r * 8 + f == b) return squares;
+      squares |= 1ULL << (r * 8 + f);
+    }
+  }
+  return 0ULL;
+}
+
+/**
+ * @brief Reference implementation: if a walk from a reaches b, the walk in both directions plus a.
+ */
+uint64_t walk_line(int a, int b) {
+  for (const auto& [df, dr] : DIRECTIONS) {
+    bool reaches_b = false;
+    uint64_t squares = 1ULL << a;
+    for (const int sign : {1, -1}) {
+      for (int f = a % 8 + sign * df, r = a / 8 + sign * dr; on_board(f, r); f += sign * df, r += sign * dr) {
+        squares |= 1ULL << (r * 8 + f);
+        reaches_b |= r * 8 + f == b;
+      }
+    }
+    if (reaches_b) return squares;
+  }
+  return 0ULL;
+}
+
+}  // namespace
+
+/**
+ * @test LinesTest.BetweenMatchesRayWalk
+ * @brief Verifies BETWEEN against a square-by-square walk for every pair of squares.
+ */
+TEST(LinesTest, BetweenMatchesRayWalk) {
+  for (int a = 0; a < 64; ++a) {
+    for (int b = 0; b < 64; ++b) {
+      EXPECT_EQ(BETWEEN[a][b].value(), walk_between(a, b)) << "a=" << a << " b=" << b;
+      EXPECT_EQ(BETWEEN[a][b], BETWEEN[b][a]);
+    }
+  }
+}
+
+/**
+ * @test LinesTest.LineMatchesRayWalk
+ * @brief Verifies LINE against a square-by-square walk for every pair of squares.
+ */
+TEST(LinesTest, LineMatchesRayWalk) {
+  for (int a = 0; a < 64; ++a) {
+    for (int b = 0; b < 64; ++b) {
+      EXPECT_EQ(LINE[a][b].value(), walk_line(a, b)) << "a=" << a << " b=" << b;
+      EXPECT_EQ(LINE[a][b], LINE[b][a]);
+    }
+  }
+}
+
+/**
+ * @test LinesTest.KnownPairs
+ * @brief Verifies a few hand-checked entries, at compile time.
+ */
+TEST(LinesTest, KnownPairs) {
+  static_assert(BETWEEN[Square::A1][Square::H8].popcount() == 6);
+  static_assert(BETWEEN[Square::E1][Square::E2].empty());
+  static_assert(BETWEEN[Square::A1][Square::B3].empty());
+  static_assert(LINE[Square::A1][Square::A1].empty());
+  static_assert(LINE[Square::B1][Square::A2] == Bitboard((1ULL << Square::B1) | (1ULL << Square::A2)));
+
+  EXPECT_EQ(BETWEEN[Square::E1][Square::E8].value(), 0x0010101010101000ULL);
+  EXPECT_EQ(LINE[Square::C3][Square::F6].value(), 0x8040201008040201ULL);
+  EXPECT_EQ(LINE[Square::D4][Square::H4].value(), 0x00000000FF000000ULL);
+}
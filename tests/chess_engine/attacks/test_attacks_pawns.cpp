@@ -73,3 +73,31 @@ TEST(PawnAttackTest, BlackPawnAttacksFromE5) {
 
   EXPECT_EQ(BLACK_PAWN_ATTACKS[Square::E5], expected);
 }
+
+/**
+ * @test White pawn attacks from the edge files
+ * Expected: White pawn on A2 only attacks B3, on H2 only G3 (no wrap-around to the other side of the board)
+ */
+TEST(PawnAttackTest, WhitePawnAttacksDoNotWrap) {
+  Bitboard expected_a;
+  expected_a.set(Square::B3);
+  EXPECT_EQ(WHITE_PAWN_ATTACKS[Square::A2], expected_a);
+
+  Bitboard expected_h;
+  expected_h.set(Square::G3);
+  EXPECT_EQ(WHITE_PAWN_ATTACKS[Square::H2], expected_h);
+}
+
+/**
+ * @test Black pawn attacks from the edge files
+ * Expected: Black pawn on A7 only attacks B6, on H7 only G6 (no wrap-around to the other side of the board)
+ */
+TEST(PawnAttackTest, BlackPawnAttacksDoNotWrap) {
+  Bitboard expected_a;
+  expected_a.set(Square::B6);
+  EXPECT_EQ(BLACK_PAWN_ATTACKS[Square::A7], expected_a);
+
+  Bitboard expected_h;
+  expected_h.set(Square::G6);
+  EXPECT_EQ(BLACK_PAWN_ATTACKS[Square::H7], expected_h);
+}
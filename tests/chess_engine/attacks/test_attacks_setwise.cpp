@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <chess_engine/attacks/queen.hpp>
+#include <chess_engine/attacks/setwise.hpp>
+#include <chess_engine/attacks/sliders.hpp>
+#include <chess_engine/bitboard.hpp>
+#include <chess_engine/bitmasks.hpp>
+#include <chess_engine/square.hpp>
+#include <cstdint>
+
+using namespace Attacks;
+
+namespace {
+
+uint64_t next_random(uint64_t& state) {
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  return state * 2685821657736338717ULL;
+}
+
+/**
+ * @brief Reference implementation: union of the per-square lookups of every piece of the set.
+ */
+template <typename Lookup>
+uint64_t union_of_lookups(uint64_t pieces, uint64_t occupancy, Lookup lookup) {
+  uint64_t attacks = 0ULL;
+  for (int sq = 0; sq < 64; ++sq) {
+    if ((pieces >> sq) & 1ULL) attacks |= lookup(Square(sq), Bitboard(occupancy)).value();
+  }
+  return attacks;
+}
+
+}  // namespace
+
+/**
+ * @test SetwiseAttacksTest.SinglePieceMatchesLookup
+ * @brief Verifies a lone slider on every square, on an empty board and surrounded by blockers.
+ */
+TEST(SetwiseAttacksTest, SinglePieceMatchesLookup) {
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (int sq = 0; sq < 64; ++sq) {
+    const uint64_t piece = 1ULL << sq;
+    for (int i = 0; i < 16; ++i) {
+      const uint64_t occupancy = (i == 0 ? 0ULL : next_random(state) & next_random(state)) | piece;
+      const Bitboard empty(~occupancy);
+      EXPECT_EQ(rook_attacks_setwise(piece, empty), rook_attacks(Square(sq), occupancy)) << "square " << sq;
+      EXPECT_EQ(bishop_attacks_setwise(piece, empty), bishop_attacks(Square(sq), occupancy)) << "square " << sq;
+      EXPECT_EQ(queen_attacks_setwise(piece, empty), queen_attacks(Square(sq), occupancy)) << "square " << sq;
+    }
+  }
+}
+
+/**
+ * @test SetwiseAttacksTest.PieceSetsMatchUnionOfLookups
+ * @brief Verifies random piece sets, including sliders blocking each other, against the union of lookups.
+ */
+TEST(SetwiseAttacksTest, PieceSetsMatchUnionOfLookups) {
+  uint64_t state = 0x0123456789ABCDEFULL;
+  for (int i = 0; i < 10000; ++i) {
+    const uint64_t pieces = next_random(state) & next_random(state) & next_random(state);
+    const uint64_t occupancy = (next_random(state) & next_random(state)) | pieces;
+    const Bitboard empty(~occupancy);
+
+    ASSERT_EQ(rook_attacks_setwise(pieces, empty).value(), union_of_lookups(pieces, occupancy, rook_attacks));
+    ASSERT_EQ(bishop_attacks_setwise(pieces, empty).value(), union_of_lookups(pieces, occupancy, bishop_attacks));
+  }
+}
+
+/**
+ * @test SetwiseAttacksTest.NoWrapAroundEdges
+ * @brief Verifies that fills along ranks and diagonals stop at the A and H files.
+ */
+TEST(SetwiseAttacksTest, NoWrapAroundEdges) {
+  const Bitboard h_file_rook(1ULL << Square::H4);
+  EXPECT_FALSE(rook_attacks_setwise(h_file_rook, ~0ULL).test(Square::A5));
+
+  const Bitboard a_file_bishop(1ULL << Square::A4);
+  EXPECT_FALSE(bishop_attacks_setwise(a_file_bishop, ~0ULL).test(Square::H4));
+  EXPECT_FALSE(bishop_attacks_setwise(a_file_bishop, ~0ULL).test(Square::H2));
+}
+
+/**
+ * @test SetwiseAttacksTest.CompileTimeEvaluation
+ * @brief Verifies that the fills are usable in constant expressions.
+ */
+TEST(SetwiseAttacksTest, CompileTimeEvaluation) {
+  constexpr Bitboard corners((1ULL << Square::A1) | (1ULL << Square::H8));
+  constexpr uint64_t border = Bitmasks::FILE_A | Bitmasks::FILE_H | Bitmasks::RANK_1 | Bitmasks::RANK_8;
+  static_assert(rook_attacks_setwise(corners, ~corners.value()).value() == (border & ~corners.value()));
+  SUCCEED();
+}
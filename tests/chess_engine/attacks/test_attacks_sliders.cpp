@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <chess_engine/attacks/magic.hpp>
+#include <chess_engine/attacks/pext.hpp>
+#include <chess_engine/attacks/queen.hpp>
+#include <chess_engine/attacks/sliders.hpp>
+#include <chess_engine/bitboard.hpp>
+#include <chess_engine/square.hpp>
+#include <cstdint>
+#include <string>
+
+using namespace Attacks;
+
+namespace {
+
+/**
+ * @brief Reference implementation: walks each ray square by square until it leaves the board or hits a blocker.
+ */
+uint64_t ray_walk(int sq, uint64_t occupancy, const int (*directions)[2]) {
+  uint64_t attacks = 0ULL;
+  for (int d = 0; d < 4; ++d) {
+    int file = sq % 8 + directions[d][0];
+    int rank = sq / 8 + directions[d][1];
+    while (file >= 0 && file < 8 && rank >= 0 && rank < 8) {
+      const uint64_t bit = 1ULL << (rank * 8 + file);
+      attacks |= bit;
+      if (occupancy & bit) break;
+      file += directions[d][0];
+      rank += directions[d][1];
+    }
+  }
+  return attacks;
+}
+
+constexpr int ROOK_DIRECTIONS[4][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
+constexpr int BISHOP_DIRECTIONS[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+uint64_t rook_reference(int sq, uint64_t occupancy) { return ray_walk(sq, occupancy, ROOK_DIRECTIONS); }
+uint64_t bishop_reference(int sq, uint64_t occupancy) { return ray_walk(sq, occupancy, BISHOP_DIRECTIONS); }
+
+/**
+ * @brief Deterministic xorshift generator for the noise bits outside of the relevance masks.
+ */
+uint64_t next_random(uint64_t& state) {
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  return state * 2685821657736338717ULL;
+}
+
+/**
+ * @brief Runs each test once per slider backend, restoring the startup backend afterwards.
+ */
+class SliderAttacksTest : public ::testing::TestWithParam<SliderBackend> {
+ protected:
+  SliderBackend m_startup_backend = slider_backend();
+
+  void SetUp() override {
+    if (!select_slider_backend(GetParam())) {
+      GTEST_SKIP() << slider_backend_name(GetParam()) << " backend is not supported on this CPU";
+    }
+  }
+
+  void TearDown() override { select_slider_backend(m_startup_backend); }
+};
+
+}  // namespace
+
+/**
+ * @test Relevance masks
+ * @brief Relevance masks exclude the last square of each ray (the board edge).
+ */
+TEST(SliderTablesTest, RelevanceMasks) {
+  // Rook on A1: A2..A7 and B1..G1
+  Bitboard expected_rook((Bitmasks::FILE_A | Bitmasks::RANK_1) & ~(Bitmasks::RANK_8 | Bitmasks::FILE_H));
+  expected_rook.clear(Square::A1);
+  EXPECT_EQ(ROOK_MASKS[Square::A1], expected_rook);
+
+  // Bishop on D4: 9 inner diagonal squares
+  Bitboard expected_bishop;
+  for (auto sq : {Square::C3, Square::B2, Square::E5, Square::F6, Square::G7, Square::C5, Square::B6, Square::E3,
+                  Square::F2}) {
+    expected_bishop.set(sq);
+  }
+  EXPECT_EQ(BISHOP_MASKS[Square::D4], expected_bishop);
+}
+
+/**
+ * @test PEXT table sizes
+ * @brief Packed PEXT tables hold exactly 2^popcount(mask) entries per square.
+ */
+TEST(SliderTablesTest, PextTableSizes) {
+  EXPECT_EQ(ROOK_PEXT_TABLE_SIZE, 102400u);
+  EXPECT_EQ(BISHOP_PEXT_TABLE_SIZE, 5248u);
+}
+
+/**
+ * @test Software and hardware PEXT agree
+ * @brief pext() packs the selected bits in order, whatever the implementation used by this build.
+ */
+TEST(SliderTablesTest, PextPacksSelectedBits) {
+  if (PEXT_COMPILED && !slider_backend_supported(SliderBackend::Pext)) {
+    GTEST_SKIP() << "PEXT is not supported on this CPU";
+  }
+  EXPECT_EQ(pext(0b1011'0110ULL, 0b1111'0000ULL), 0b1011ULL);
+  EXPECT_EQ(pext(0xFFFF'FFFF'FFFF'FFFFULL, 0x8000'0000'0000'0001ULL), 0b11ULL);
+  EXPECT_EQ(pext(0x8000'0000'0000'0000ULL, 0x8000'0000'0000'0001ULL), 0b10ULL);
+}
+
+/**
+ * @test Empty board
+ * @brief With no blockers, occupancy-aware attacks match the empty-board tables.
+ */
+TEST_P(SliderAttacksTest, EmptyBoardMatchesRayTables) {
+  for (int sq = 0; sq < 64; ++sq) {
+    const Square square(sq);
+    EXPECT_EQ(rook_attacks(square, Bitboard()), ROOK_ATTACKS[sq]);
+    EXPECT_EQ(bishop_attacks(square, Bitboard()), BISHOP_ATTACKS[sq]);
+    EXPECT_EQ(queen_attacks(square, Bitboard()), QUEEN_ATTACKS[sq]);
+  }
+}
+
+/**
+ * @test Blocked rook
+ * @brief Rook on D4 blocked on D6 and F4: attacks include the blockers but nothing behind them.
+ */
+TEST_P(SliderAttacksTest, RookStopsAtBlockers) {
+  Bitboard occupancy;
+  occupancy.set(Square::D6);
+  occupancy.set(Square::F4);
+  occupancy.set(Square::H4);  // hidden behind F4
+
+  Bitboard expected;
+  for (auto sq : {Square::D5, Square::D6, Square::D3, Square::D2, Square::D1, Square::E4, Square::F4, Square::C4,
+                  Square::B4, Square::A4}) {
+    expected.set(sq);
+  }
+  EXPECT_EQ(rook_attacks(Square(Square::D4), occupancy), expected);
+}
+
+/**
+ * @test Exhaustive rook check
+ * @brief Every subset of every rook relevance mask, with random noise outside the mask, matches the ray walk.
+ */
+TEST_P(SliderAttacksTest, RookExhaustive) {
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (int sq = 0; sq < 64; ++sq) {
+    const uint64_t mask = ROOK_MASKS[sq].value();
+    uint64_t subset = 0ULL;
+    do {
+      const uint64_t occupancy = subset | (next_random(state) & ~mask);
+      ASSERT_EQ(rook_attacks(Square(sq), Bitboard(occupancy)).value(), rook_reference(sq, occupancy))
+          << "square " << sq << " occupancy " << occupancy;
+      subset = (subset - mask) & mask;
+    } while (subset != 0ULL);
+  }
+}
+
+/**
+ * @test Exhaustive bishop check
+ * @brief Every subset of every bishop relevance mask, with random noise outside the mask, matches the ray walk.
+ */
+TEST_P(SliderAttacksTest, BishopExhaustive) {
+  uint64_t state = 0xD1B54A32D192ED03ULL;
+  for (int sq = 0; sq < 64; ++sq) {
+    const uint64_t mask = BISHOP_MASKS[sq].value();
+    uint64_t subset = 0ULL;
+    do {
+      const uint64_t occupancy = subset | (next_random(state) & ~mask);
+      ASSERT_EQ(bishop_attacks(Square(sq), Bitboard(occupancy)).value(), bishop_reference(sq, occupancy))
+          << "square " << sq << " occupancy " << occupancy;
+      subset = (subset - mask) & mask;
+    } while (subset != 0ULL);
+  }
+}
+
+/**
+ * @test Queen on random occupancies
+ * @brief Queen attacks equal the union of the rook and bishop ray walks.
+ */
+TEST_P(SliderAttacksTest, QueenRandomOccupancies) {
+  uint64_t state = 0x2545F4914F6CDD1DULL;
+  for (int i = 0; i < 100000; ++i) {
+    const int sq = static_cast<int>(next_random(state) % 64);
+    const uint64_t occupancy = next_random(state) & next_random(state);
+    ASSERT_EQ(queen_attacks(Square(sq), Bitboard(occupancy)).value(),
+              rook_reference(sq, occupancy) | bishop_reference(sq, occupancy));
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, SliderAttacksTest, ::testing::Values(SliderBackend::Magic, SliderBackend::Pext),
+                         [](const ::testing::TestParamInfo<SliderBackend>& info) {
+                           return std::string(slider_backend_name(info.param));
+                         });
@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <chess_engine/bitboard.hpp>
+#include <chess_engine/bitmasks.hpp>
 #include <chess_engine/square.hpp>
 #include <sstream>
+#include <vector>
 
 /**
  * @test Print function.
@@ -244,3 +246,98 @@ TEST(BitboardTest, ShiftRight) {
   Bitboard b2(0x1000);                     // binary: ...0001 0000 0000 0000  (only bit 12 set -> square E2)
   EXPECT_EQ((b2 >> 4).value(), 0x100ULL);  // binary: ...0000 0001 0000 0000  (only bit 8 set -> square A2)
 }
+
+/**
+ * @test Bitwise XOR operators.
+ * @brief Confirms ^ keeps squares set in exactly one operand and ^= toggles squares in place.
+ */
+TEST(BitboardTest, XorOperators) {
+  Bitboard a(0b1100), b(0b1010);
+  EXPECT_EQ((a ^ b).value(), 0b0110ULL);
+
+  a ^= b;
+  EXPECT_EQ(a.value(), 0b0110ULL);
+  a ^= b;
+  EXPECT_EQ(a.value(), 0b1100ULL);
+}
+
+/**
+ * @test Population count.
+ * @brief Counts set squares, and detects more than one set square.
+ */
+TEST(BitboardTest, Popcount) {
+  EXPECT_EQ(Bitboard().popcount(), 0);
+  EXPECT_EQ(Bitboard(0x8000000000000001ULL).popcount(), 2);
+  EXPECT_EQ(Bitboard(~0ULL).popcount(), 64);
+
+  EXPECT_TRUE(Bitboard().empty());
+  EXPECT_FALSE(Bitboard(1ULL << Square::E4).more_than_one());
+  EXPECT_TRUE(Bitboard(0x8000000000000001ULL).more_than_one());
+  static_assert(Bitboard(0xFFULL).popcount() == 8);
+}
+
+/**
+ * @test Least significant bit scan.
+ * @brief lsb returns the lowest set square, pop_lsb also clears it.
+ */
+TEST(BitboardTest, LsbAndPopLsb) {
+  Bitboard bb;
+  bb.set(Square::H8);
+  bb.set(Square::C3);
+  bb.set(Square::E4);
+
+  EXPECT_EQ(bb.lsb(), Square(Square::C3));
+  EXPECT_EQ(bb.pop_lsb(), Square(Square::C3));
+  EXPECT_EQ(bb.pop_lsb(), Square(Square::E4));
+  EXPECT_EQ(bb.pop_lsb(), Square(Square::H8));
+  EXPECT_TRUE(bb.empty());
+  static_assert(Bitboard(1ULL << Square::H8).lsb() == Square(Square::H8));
+}
+
+/**
+ * @test Range-for iteration.
+ * @brief Iterating yields every set square once, in increasing order.
+ */
+TEST(BitboardTest, RangeForIteratesSetSquares) {
+  const Bitboard bb(0x8100000000000081ULL);  // the four corners
+  std::vector<Square> squares;
+  for (Square sq : bb) squares.push_back(sq);
+
+  const std::vector<Square> expected = {Square(Square::A1), Square(Square::H1), Square(Square::A8),
+                                        Square(Square::H8)};
+  EXPECT_EQ(squares, expected);
+
+  int count = 0;
+  for ([[maybe_unused]] Square sq : Bitboard()) ++count;
+  EXPECT_EQ(count, 0);
+}
+
+/**
+ * @test Direction shifts.
+ * @brief One step in each direction, with squares leaving the board dropped instead of wrapping.
+ */
+TEST(BitboardTest, ShiftDirections) {
+  const Bitboard e4(1ULL << Square::E4);
+  EXPECT_EQ(e4.shift<NORTH>(), Bitboard(1ULL << Square::E5));
+  EXPECT_EQ(e4.shift<SOUTH>(), Bitboard(1ULL << Square::E3));
+  EXPECT_EQ(e4.shift<EAST>(), Bitboard(1ULL << Square::F4));
+  EXPECT_EQ(e4.shift<WEST>(), Bitboard(1ULL << Square::D4));
+  EXPECT_EQ(e4.shift<NORTH_EAST>(), Bitboard(1ULL << Square::F5));
+  EXPECT_EQ(e4.shift<NORTH_WEST>(), Bitboard(1ULL << Square::D5));
+  EXPECT_EQ(e4.shift<SOUTH_EAST>(), Bitboard(1ULL << Square::F3));
+  EXPECT_EQ(e4.shift<SOUTH_WEST>(), Bitboard(1ULL << Square::D3));
+
+  const Bitboard h_file(Bitmasks::FILE_H);
+  EXPECT_TRUE(h_file.shift<EAST>().empty());
+  EXPECT_TRUE(h_file.shift<NORTH_EAST>().empty());
+  EXPECT_TRUE(h_file.shift<SOUTH_EAST>().empty());
+
+  const Bitboard a_file(Bitmasks::FILE_A);
+  EXPECT_TRUE(a_file.shift<WEST>().empty());
+  EXPECT_TRUE(a_file.shift<NORTH_WEST>().empty());
+  EXPECT_TRUE(a_file.shift<SOUTH_WEST>().empty());
+
+  EXPECT_TRUE(Bitboard(Bitmasks::RANK_8).shift<NORTH>().empty());
+  EXPECT_TRUE(Bitboard(Bitmasks::RANK_1).shift<SOUTH>().empty());
+  static_assert(Bitboard(Bitmasks::RANK_1).shift<NORTH>() == Bitboard(Bitmasks::RANK_2));
+}
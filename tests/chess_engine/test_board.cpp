@@ -4,6 +4,7 @@
 #include <chess_engine/piece.hpp>
 #include <chess_engine/square.hpp>
 #include <sstream>
+#include <type_traits>
 
 /**
  * @test BoardTest.DefaultStartingPosDefaultConstructor
@@ -146,3 +147,286 @@ TEST(BoardTest, PrintBoard) {
 
   EXPECT_EQ(output, expected);
 }
+
+/**
+ * @test BoardTest.MailboxMatchesBitboards
+ * @brief Verifies that the mailbox and the bitboards stay in sync through a sequence of edits.
+ *
+ * Checks:
+ * - Consistency after construction, placement, replacement and removal
+ * - Removing an empty square is a no-op
+ */
+TEST(BoardTest, MailboxMatchesBitboards) {
+  Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+  EXPECT_TRUE(board.is_consistent());
+
+  board.set_piece(Square(Square::E5), Piece('q'));  // capture-like replacement
+  EXPECT_TRUE(board.is_consistent());
+  EXPECT_EQ(board.get_piece(Square(Square::E5)), Piece('q'));
+  EXPECT_TRUE(board.black_pieces().test(Square::E5));
+  EXPECT_FALSE(board.white_pieces().test(Square::E5));
+
+  board.remove_piece(Square(Square::D4));  // already empty
+  EXPECT_TRUE(board.is_consistent());
+  EXPECT_EQ(board.get_piece(Square(Square::D4)), Piece('.'));
+
+  board.set_piece(Square(Square::A1), Piece('.'));  // placing NO_PIECE clears the square
+  EXPECT_TRUE(board.is_consistent());
+  EXPECT_FALSE(board.occupied().test(Square::A1));
+}
+
+/**
+ * @test BoardTest.OccupancyCachesFollowEdits
+ * @brief Verifies that the cached color and total occupancies follow placements, replacements and removals.
+ */
+TEST(BoardTest, OccupancyCachesFollowEdits) {
+  // FENs need both kings: start from them and edit them away
+  Board board("4k3/8/8/8/8/8/8/4K3 w - - 0 1");
+  board.remove_piece(Square(Square::E1));
+  board.remove_piece(Square(Square::E8));
+  EXPECT_EQ(board.occupied(), Bitboard());
+
+  board.set_piece(Square(Square::E4), Piece('N'));
+  EXPECT_EQ(board.pieces(Piece::WHITE), Bitboard(1ULL << Square::E4));
+  EXPECT_EQ(board.pieces(Piece::BLACK), Bitboard());
+
+  board.set_piece(Square(Square::E4), Piece('b'));  // replaced by a black piece
+  EXPECT_EQ(board.white_pieces(), Bitboard());
+  EXPECT_EQ(board.black_pieces(), Bitboard(1ULL << Square::E4));
+  EXPECT_EQ(board.occupied(), Bitboard(1ULL << Square::E4));
+
+  board.remove_piece(Square(Square::E4));
+  EXPECT_EQ(board.occupied(), Bitboard());
+  EXPECT_TRUE(board.is_consistent());
+}
+
+namespace {
+
+/**
+ * @brief Checks that two boards hold the same pieces and the same game state.
+ */
+void expect_same_position(const Board& actual, const Board& expected) {
+  for (int index = 0; index < 64; ++index) {
+    const Square sq(index);
+    EXPECT_EQ(actual.get_piece(sq), expected.get_piece(sq)) << "on " << sq.to_string();
+  }
+  EXPECT_EQ(actual.is_white_turn(), expected.is_white_turn());
+  EXPECT_EQ(actual.castling_rights(), expected.castling_rights());
+  EXPECT_EQ(actual.en_passant_square(), expected.en_passant_square());
+  EXPECT_EQ(actual.halfmove_clock(), expected.halfmove_clock());
+  EXPECT_EQ(actual.fullmove_number(), expected.fullmove_number());
+  EXPECT_EQ(actual.hash(), expected.hash());
+  EXPECT_TRUE(actual.is_consistent());
+}
+
+/**
+ * @brief Plays a move, checks the resulting position, takes it back and checks the original one.
+ */
+void expect_make_unmake(const std::string& fen, Move move, const std::string& expected_fen) {
+  Board board(fen);
+  const Board::UndoInfo undo = board.make_move(move);
+  expect_same_position(board, Board(expected_fen));
+  EXPECT_EQ(board.hash(), board.compute_hash());
+
+  board.unmake_move(move, undo);
+  expect_same_position(board, Board(fen));
+}
+
+}  // namespace
+
+/**
+ * @test BoardTest.MakeUnmakeQuietMove
+ * @brief Verifies a knight move: halfmove clock increases, fullmove number increases after Black.
+ */
+TEST(BoardTest, MakeUnmakeQuietMove) {
+  expect_make_unmake("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+                     Move(Square(Square::G1), Square(Square::F3)),
+                     "rnbqkbnr/pppppppp/8/8/8/5N2/PPPPPPPP/RNBQKB1R b KQkq - 1 1");
+  expect_make_unmake("rnbqkbnr/pppppppp/8/8/8/5N2/PPPPPPPP/RNBQKB1R b KQkq - 1 1",
+                     Move(Square(Square::B8), Square(Square::C6)),
+                     "r1bqkbnr/pppppppp/2n5/8/8/5N2/PPPPPPPP/RNBQKB1R w KQkq - 2 2");
+}
+
+/**
+ * @test BoardTest.MakeUnmakeDoublePush
+ * @brief Verifies that a double push only sets the en passant square when an enemy pawn can capture.
+ */
+TEST(BoardTest, MakeUnmakeDoublePush) {
+  // No black pawn next to e4: no en passant square
+  expect_make_unmake("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+                     Move(Square(Square::E2), Square(Square::E4)),
+                     "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1");
+  // Black pawn on d4 can take on e3
+  expect_make_unmake("4k3/8/8/8/3p4/8/4P3/4K3 w - - 3 20", Move(Square(Square::E2), Square(Square::E4)),
+                     "4k3/8/8/8/3pP3/8/8/4K3 b - e3 0 20");
+}
+
+/**
+ * @test BoardTest.MakeUnmakeCapture
+ * @brief Verifies a capture: captured piece removed, clock reset, restored by unmake.
+ */
+TEST(BoardTest, MakeUnmakeCapture) {
+  expect_make_unmake("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 5 10",
+                     Move(Square(Square::E5), Square(Square::F7)),
+                     "r3k2r/p1ppqNb1/bn2pnp1/3P4/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 10");
+}
+
+/**
+ * @test BoardTest.MakeUnmakeEnPassant
+ * @brief Verifies that an en passant capture removes the pawn behind the destination square.
+ */
+TEST(BoardTest, MakeUnmakeEnPassant) {
+  expect_make_unmake("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 2",
+                     Move(Square(Square::E5), Square(Square::D6), Move::EN_PASSANT),
+                     "4k3/8/3P4/8/8/8/8/4K3 b - - 0 2");
+  expect_make_unmake("4k3/8/8/8/3pP3/8/8/4K3 b - e3 0 2",
+                     Move(Square(Square::D4), Square(Square::E3), Move::EN_PASSANT),
+                     "4k3/8/8/8/8/4p3/8/4K3 w - - 0 3");
+}
+
+/**
+ * @test BoardTest.MakeUnmakeCastling
+ * @brief Verifies that castling moves the rook as well and clears both rights of the side.
+ */
+TEST(BoardTest, MakeUnmakeCastling) {
+  expect_make_unmake("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1",
+                     Move(Square(Square::E1), Square(Square::G1), Move::CASTLING),
+                     "r3k2r/8/8/8/8/8/8/R4RK1 b kq - 1 1");
+  expect_make_unmake("r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1",
+                     Move(Square(Square::E8), Square(Square::C8), Move::CASTLING),
+                     "2kr3r/8/8/8/8/8/8/R3K2R w KQ - 1 2");
+}
+
+/**
+ * @test BoardTest.MakeUnmakeCastlingRightsLoss
+ * @brief Verifies that moving a rook or capturing one on its starting square removes the matching right.
+ */
+TEST(BoardTest, MakeUnmakeCastlingRightsLoss) {
+  expect_make_unmake("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1", Move(Square(Square::A1), Square(Square::A8)),
+                     "R3k2r/8/8/8/8/8/8/4K2R b Kk - 0 1");
+}
+
+/**
+ * @test BoardTest.MakeUnmakePromotion
+ * @brief Verifies plain and capturing promotions for both colors.
+ */
+TEST(BoardTest, MakeUnmakePromotion) {
+  expect_make_unmake("1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1",
+                     Move::make_promotion(Square(Square::A7), Square(Square::A8), Piece::Q),
+                     "Qr2k3/8/8/8/8/8/8/4K3 b - - 0 1");
+  expect_make_unmake("1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1",
+                     Move::make_promotion(Square(Square::A7), Square(Square::B8), Piece::N),
+                     "1N2k3/8/8/8/8/8/8/4K3 b - - 0 1");
+  expect_make_unmake("4k3/8/8/8/8/8/6p1/4K2R b K - 0 1",
+                     Move::make_promotion(Square(Square::G2), Square(Square::H1), Piece::r),
+                     "4k3/8/8/8/8/8/8/4K2r w - - 0 2");
+}
+
+/**
+ * @test BoardTest.PackedState
+ * @brief Verifies the packed layout: one 8-byte state word, no padding, trivially copyable for copy-make.
+ */
+TEST(BoardTest, PackedState) {
+  static_assert(std::is_trivially_copyable_v<Board>);
+  EXPECT_EQ(sizeof(Board::State), 8u);
+  EXPECT_EQ(alignof(Board::State), 8u);
+  EXPECT_EQ(sizeof(Board), 200u);
+
+  Board board("4k3/8/8/3pP3/8/8/8/R3K2R w KQ d6 65535 65535");
+  EXPECT_EQ(board.castling_rights(), Board::WHITE_KINGSIDE | Board::WHITE_QUEENSIDE);
+  EXPECT_EQ(board.en_passant_square(), Square(Square::D6));
+  EXPECT_EQ(board.halfmove_clock(), 65535);
+  EXPECT_EQ(board.fullmove_number(), 65535);
+
+  // A copy is a complete, independent position
+  Board copy = board;
+  copy.make_move(Move(Square(Square::E5), Square(Square::D6), Move::EN_PASSANT));
+  EXPECT_EQ(copy.to_fen(), "4k3/8/3P4/8/8/8/8/R3K2R b KQ - 0 65535");
+  EXPECT_EQ(board.to_fen(), "4k3/8/8/3pP3/8/8/8/R3K2R w KQ d6 65535 65535");
+  EXPECT_EQ(copy.hash(), copy.compute_hash());
+}
+
+namespace {
+
+const char* ATTACK_FENS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+};
+
+}  // namespace
+
+/**
+ * @test BoardTest.AttackersToMatchesIsSquareAttacked
+ * @brief Verifies that the attackers of each color are found exactly when is_square_attacked() reports an attack.
+ */
+TEST(BoardTest, AttackersToMatchesIsSquareAttacked) {
+  for (const char* fen : ATTACK_FENS) {
+    const Board board(fen);
+    for (int index = 0; index < 64; ++index) {
+      const Square sq(index);
+      const Bitboard attackers = board.attackers_to(sq);
+      EXPECT_EQ(attackers, board.attackers_to(sq, board.occupied()));
+      EXPECT_EQ(!(attackers & board.white_pieces()).empty(), board.is_square_attacked(sq, Piece::WHITE));
+      EXPECT_EQ(!(attackers & board.black_pieces()).empty(), board.is_square_attacked(sq, Piece::BLACK));
+    }
+  }
+}
+
+/**
+ * @test BoardTest.AttackersToCustomOccupancy
+ * @brief Verifies both colors are returned, and that removing a piece from the occupancy reveals x-ray attackers.
+ */
+TEST(BoardTest, AttackersToCustomOccupancy) {
+  // d4 is attacked by the e3 pawn, the f3 knight and the d1 rook, and by the d8 rook and the b6 bishop
+  const Board board("3r3k/8/1b6/8/3p4/4PN2/8/3R3K w - - 0 1");
+  const Square d4(Square::D4);
+  const Bitboard expected = Bitboard(1ULL << Square::E3) | Bitboard(1ULL << Square::F3) |
+                            Bitboard(1ULL << Square::D1) | Bitboard(1ULL << Square::D8) | Bitboard(1ULL << Square::B6);
+  EXPECT_EQ(board.attackers_to(d4), expected);
+
+  // With a rook on d2 in front of d1, the d1 rook is hidden until d2 is removed from the occupancy
+  Board stacked = board;
+  stacked.set_piece(Square(Square::D2), Piece('R'));
+  EXPECT_FALSE(stacked.attackers_to(d4).test(Square(Square::D1)));
+  const Bitboard xray = stacked.occupied() ^ Bitboard(1ULL << Square::D2);
+  EXPECT_TRUE(stacked.attackers_to(d4, xray).test(Square(Square::D1)));
+}
+
+/**
+ * @test BoardTest.AttackedSquaresMatchesIsSquareAttacked
+ * @brief Verifies the per-side attack maps square by square, and that the AttackMaps cache follows moves and edits.
+ */
+TEST(BoardTest, AttackedSquaresMatchesIsSquareAttacked) {
+  AttackMaps maps;
+  auto expect_maps = [&maps](const Board& board) {
+    for (const Piece::Color by : {Piece::WHITE, Piece::BLACK}) {
+      const Bitboard attacked = board.attacked_squares(by);
+      EXPECT_EQ(maps.attacked_squares(board, by), attacked);
+      EXPECT_EQ(maps.attacked_squares(board, by), attacked);  // cached
+      for (int index = 0; index < 64; ++index) {
+        EXPECT_EQ(attacked.test(Square(index)), board.is_square_attacked(Square(index), by)) << index;
+      }
+    }
+  };
+
+  for (const char* fen : ATTACK_FENS) {
+    Board board(fen);
+    expect_maps(board);
+
+    board.set_piece(Square(Square::D5), Piece('q'));
+    expect_maps(board);
+    board.remove_piece(Square(Square::D5));
+    expect_maps(board);
+  }
+
+  Board board;
+  expect_maps(board);
+  const Move e4(Square(Square::E2), Square(Square::E4));
+  const Board::UndoInfo undo = board.make_move(e4);
+  expect_maps(board);
+  board.unmake_move(e4, undo);
+  expect_maps(board);
+}
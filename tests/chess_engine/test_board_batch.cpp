@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <chess_engine/attacks/pawn.hpp>
+#include <chess_engine/attacks/sliders.hpp>
+#include <chess_engine/board.hpp>
+#include <chess_engine/board_batch.hpp>
+#include <chess_engine/movegen.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Positions reached by random legal games from the reference positions, 203 in total
+ * so that the AVX2 backend also goes through its scalar tail.
+ */
+std::vector<Board> make_positions() {
+  const char* fens[] = {
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+      "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+      "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+      "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+  };
+  std::vector<Board> positions;
+  uint64_t state = 0x2545F4914F6CDD1DULL;
+  for (int game = 0; positions.size() < 203; ++game) {
+    Board board(fens[game % 4]);
+    for (int ply = 0; ply < 60 && positions.size() < 203; ++ply) {
+      positions.push_back(board);
+      MoveList moves;
+      MoveGen::generate_legal(board, moves);
+      if (moves.empty()) break;
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      board.make_move(moves[state % moves.size()]);
+    }
+  }
+  return positions;
+}
+
+/**
+ * @brief Scalar Board path: union of the per-square table lookups of every piece of a set.
+ */
+template <typename Lookup>
+uint64_t union_over(uint64_t pieces, Lookup lookup) {
+  uint64_t attacks = 0ULL;
+  for (; pieces; pieces &= pieces - 1) attacks |= lookup(std::countr_zero(pieces));
+  return attacks;
+}
+
+/**
+ * @brief Runs each test once per kernel backend, restoring the startup backend afterwards.
+ */
+class BoardBatchTest : public ::testing::TestWithParam<BatchKernels::Backend> {
+ protected:
+  BatchKernels::Backend m_startup_backend = BatchKernels::backend();
+  std::vector<Board> m_positions = make_positions();
+  BoardBatch m_batch;
+
+  void SetUp() override {
+    if (!BatchKernels::select_backend(GetParam())) {
+      GTEST_SKIP() << BatchKernels::backend_name(GetParam()) << " backend is not supported on this CPU";
+    }
+    for (const Board& board : m_positions) m_batch.push_back(board);
+  }
+
+  void TearDown() override { BatchKernels::select_backend(m_startup_backend); }
+};
+
+}  // namespace
+
+/**
+ * @test BoardBatchTest.StoresPieceBitboards
+ * @brief Verifies that the struct-of-arrays layout holds the bitboards of every position.
+ */
+TEST_P(BoardBatchTest, StoresPieceBitboards) {
+  ASSERT_EQ(m_batch.size(), m_positions.size());
+  for (std::size_t i = 0; i < m_positions.size(); ++i) {
+    for (int type = Piece::P; type <= Piece::k; ++type) {
+      ASSERT_EQ(m_batch.pieces(static_cast<Piece::Type>(type))[i],
+                m_positions[i].pieces(static_cast<Piece::Type>(type)).value());
+    }
+  }
+  m_batch.clear();
+  EXPECT_TRUE(m_batch.empty());
+}
+
+/**
+ * @test BoardBatchTest.OccupancyMatchesBoard
+ * @brief Verifies per-color and total occupancy of every lane against the Board caches.
+ */
+TEST_P(BoardBatchTest, OccupancyMatchesBoard) {
+  std::vector<uint64_t> white(m_batch.size()), black(m_batch.size()), all(m_batch.size());
+  BatchKernels::occupancy(m_batch, Piece::WHITE, white);
+  BatchKernels::occupancy(m_batch, Piece::BLACK, black);
+  BatchKernels::occupancy(m_batch, all);
+
+  for (std::size_t i = 0; i < m_positions.size(); ++i) {
+    EXPECT_EQ(white[i], m_positions[i].white_pieces().value()) << "lane " << i;
+    EXPECT_EQ(black[i], m_positions[i].black_pieces().value()) << "lane " << i;
+    EXPECT_EQ(all[i], m_positions[i].occupied().value()) << "lane " << i;
+  }
+}
+
+/**
+ * @test BoardBatchTest.PawnAttacksMatchBoard
+ * @brief Verifies pawn attacks of every lane against the per-square pawn attack tables.
+ */
+TEST_P(BoardBatchTest, PawnAttacksMatchBoard) {
+  std::vector<uint64_t> white(m_batch.size()), black(m_batch.size());
+  BatchKernels::pawn_attacks(m_batch, Piece::WHITE, white);
+  BatchKernels::pawn_attacks(m_batch, Piece::BLACK, black);
+
+  for (std::size_t i = 0; i < m_positions.size(); ++i) {
+    const Board& board = m_positions[i];
+    EXPECT_EQ(white[i], union_over(board.pieces(Piece::P).value(),
+                                   [](int sq) { return Attacks::WHITE_PAWN_ATTACKS[sq].value(); }))
+        << "lane " << i;
+    EXPECT_EQ(black[i], union_over(board.pieces(Piece::p).value(),
+                                   [](int sq) { return Attacks::BLACK_PAWN_ATTACKS[sq].value(); }))
+        << "lane " << i;
+  }
+}
+
+/**
+ * @test BoardBatchTest.SliderAttacksMatchBoard
+ * @brief Verifies rook/queen and bishop/queen attacks of every lane against per-square slider lookups.
+ */
+TEST_P(BoardBatchTest, SliderAttacksMatchBoard) {
+  for (Piece::Color color : {Piece::WHITE, Piece::BLACK}) {
+    std::vector<uint64_t> rooks(m_batch.size()), bishops(m_batch.size());
+    BatchKernels::rook_attacks(m_batch, color, rooks);
+    BatchKernels::bishop_attacks(m_batch, color, bishops);
+
+    for (std::size_t i = 0; i < m_positions.size(); ++i) {
+      const Board& board = m_positions[i];
+      const Bitboard occ = board.occupied();
+      const uint64_t queens = board.pieces(Piece::make_type(color, Piece::Q)).value();
+      const uint64_t orthogonal = board.pieces(Piece::make_type(color, Piece::R)).value() | queens;
+      const uint64_t diagonal = board.pieces(Piece::make_type(color, Piece::B)).value() | queens;
+      EXPECT_EQ(rooks[i],
+                union_over(orthogonal, [&](int sq) { return Attacks::rook_attacks(Square(sq), occ).value(); }))
+          << "lane " << i;
+      EXPECT_EQ(bishops[i],
+                union_over(diagonal, [&](int sq) { return Attacks::bishop_attacks(Square(sq), occ).value(); }))
+          << "lane " << i;
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, BoardBatchTest,
+                         ::testing::Values(BatchKernels::Backend::Scalar, BatchKernels::Backend::Avx2),
+                         [](const ::testing::TestParamInfo<BatchKernels::Backend>& info) {
+                           return std::string(BatchKernels::backend_name(info.param));
+                         });
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chess_engine/board.hpp>
+#include <chess_engine/fen.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+
+constexpr std::array<std::string_view, 7> REFERENCE_FENS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+};
+
+void expect_error(std::string_view fen, FenError::Code code, std::size_t offset) {
+  const auto board = Board::from_fen(fen);
+  ASSERT_FALSE(board.has_value()) << fen;
+  EXPECT_EQ(board.error().code, code) << fen;
+  EXPECT_EQ(board.error().offset, offset) << fen;
+}
+
+}  // namespace
+
+/**
+ * @test FenTest.RoundTrip
+ * @brief Verifies that parsing then printing the reference positions gives back the same FEN.
+ */
+TEST(FenTest, RoundTrip) {
+  for (const std::string_view fen : REFERENCE_FENS) {
+    const auto board = Board::from_fen(fen);
+    ASSERT_TRUE(board.has_value()) << fen << ": " << board.error().message();
+    EXPECT_EQ(board->to_fen(), fen);
+    EXPECT_TRUE(board->is_consistent());
+    EXPECT_EQ(board->hash(), board->compute_hash());
+  }
+}
+
+/**
+ * @test FenTest.MatchesStringConstructor
+ * @brief Verifies that from_fen and the throwing constructor build the same board.
+ */
+TEST(FenTest, MatchesStringConstructor) {
+  for (const std::string_view fen : REFERENCE_FENS) {
+    const Board board(std::string{fen});
+    const auto parsed = Board::from_fen(fen);
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->hash(), board.hash());
+    EXPECT_EQ(parsed->to_fen(), board.to_fen());
+  }
+  EXPECT_EQ(Board().to_fen(), REFERENCE_FENS[0]);
+}
+
+/**
+ * @test FenTest.StateFields
+ * @brief Verifies side to move, castling rights, en passant square and clocks.
+ */
+TEST(FenTest, StateFields) {
+  const auto board = Board::from_fen("4k3/8/8/8/3pP3/8/8/R3K3 b Qk e3 7 42");
+  ASSERT_TRUE(board.has_value());
+  EXPECT_FALSE(board->is_white_turn());
+  EXPECT_EQ(board->castling_rights(), Board::WHITE_QUEENSIDE | Board::BLACK_KINGSIDE);
+  ASSERT_TRUE(board->en_passant_square().has_value());
+  EXPECT_EQ(*board->en_passant_square(), Square(4, 2));
+  EXPECT_EQ(board->halfmove_clock(), 7);
+  EXPECT_EQ(board->fullmove_number(), 42);
+}
+
+/**
+ * @test FenTest.EnPassantNeedsDoublePush
+ * @brief Verifies that an en passant square is only kept behind a pawn that just pushed two squares, with the
+ * squares it crossed empty.
+ */
+TEST(FenTest, EnPassantNeedsDoublePush) {
+  EXPECT_EQ(Board("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1").en_passant_square(), Square(Square::D6));
+
+  // No black pawn on d5: e5xd6 would capture a pawn that does not exist
+  EXPECT_FALSE(Board("4k3/8/8/4P3/8/8/8/4K3 w - d6 0 1").en_passant_square().has_value());
+  // The skipped square or the pawn's origin is occupied
+  EXPECT_FALSE(Board("4k3/8/3n4/3pP3/8/8/8/4K3 w - d6 0 1").en_passant_square().has_value());
+  EXPECT_FALSE(Board("4k3/3n4/8/3pP3/8/8/8/4K3 w - d6 0 1").en_passant_square().has_value());
+  EXPECT_FALSE(Board("4k3/8/8/8/3pP3/4B3/8/4K3 b - e3 0 1").en_passant_square().has_value());
+}
+
+/**
+ * @test FenTest.OptionalClocks
+ * @brief Verifies that the halfmove clock and fullmove number may be omitted (defaulting to 0 and 1).
+ */
+TEST(FenTest, OptionalClocks) {
+  const auto board = Board::from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -");
+  ASSERT_TRUE(board.has_value());
+  EXPECT_EQ(board->halfmove_clock(), 0);
+  EXPECT_EQ(board->fullmove_number(), 1);
+  EXPECT_EQ(board->to_fen(), REFERENCE_FENS[0]);
+}
+
+/**
+ * @test FenTest.EpdOperations
+ * @brief Verifies that EPD records parse: operations are skipped, hmvc and fmvn set the clocks.
+ */
+TEST(FenTest, EpdOperations) {
+  const auto wac = Board::from_fen("2rr3k/pp3pp1/1nnqbN1p/3pN3/2pP4/2P3Q1/PPB4P/R4RK1 w - - bm Qg6; id \"WAC.001\";");
+  ASSERT_TRUE(wac.has_value()) << wac.error().message();
+  EXPECT_EQ(wac->to_fen(), "2rr3k/pp3pp1/1nnqbN1p/3pN3/2pP4/2P3Q1/PPB4P/R4RK1 w - - 0 1");
+
+  const auto bk = Board::from_fen("1k1r4/pp1b1R2/3q2pp/4p3/2B5/4Q3/PPP2B2/2K5 b - - bm Qd1+; id \"BK.01\";");
+  ASSERT_TRUE(bk.has_value()) << bk.error().message();
+  EXPECT_FALSE(bk->is_white_turn());
+
+  const auto clocks = Board::from_fen("4k3/8/8/8/3pP3/8/8/R3K3 b Qk e3 hmvc 7; fmvn 42;");
+  ASSERT_TRUE(clocks.has_value()) << clocks.error().message();
+  EXPECT_EQ(clocks->to_fen(), "4k3/8/8/8/3pP3/8/8/R3K3 b Qk e3 7 42");
+
+  // Operations after the clocks, a quoted ';' does not end an operation
+  const auto quoted =
+      Board::from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1 c0 \"a; b\"; id \"x\";");
+  ASSERT_TRUE(quoted.has_value()) << quoted.error().message();
+  EXPECT_EQ(quoted->to_fen(), REFERENCE_FENS[0]);
+
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - bm e4", FenError::INVALID_EPD_OPERATION, 53);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1 2;", FenError::INVALID_EPD_OPERATION, 57);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - hmvc x;", FenError::INVALID_EPD_OPERATION, 53);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - id \"x\"; ", FenError::TRAILING_CHARACTERS,
+               60);
+}
+
+/**
+ * @test FenTest.StructuredErrors
+ * @brief Verifies the error code and the offset of the offending character for malformed inputs.
+ */
+TEST(FenTest, StructuredErrors) {
+  expect_error("", FenError::INVALID_RANK_SIZE, 0);
+  expect_error("rnbqkbnr/ppppxppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", FenError::INVALID_PIECE, 13);
+  expect_error("rnbqkbnr/ppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", FenError::INVALID_RANK_SIZE, 16);
+  expect_error("rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", FenError::INVALID_PIECE, 18);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1", FenError::INVALID_RANK_COUNT, 34);
+  expect_error("rnbq1bnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQ - 0 1", FenError::INVALID_KING_COUNT, 0);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKKNR w kq - 0 1", FenError::INVALID_KING_COUNT, 0);
+  expect_error("8/8/8/8/8/8/8/8 w - - 0 1", FenError::INVALID_KING_COUNT, 0);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNP w Qkq - 0 1", FenError::INVALID_PAWN_RANK, 42);
+  expect_error("rnbqkbnp/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQq - 0 1", FenError::INVALID_PAWN_RANK, 7);
+  expect_error("k2q3b/b2Q2b1/1bNQNb2/1NbQbN2/qQQ1QQqq/1NbQbN2/1bNQNb1K/b2q2b1 w - - 0 1", FenError::INVALID_PIECE_COUNT,
+               0);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/Q7/PPPPPPPP/RNBQKBNR w KQkq - 0 1", FenError::INVALID_PIECE_COUNT, 0);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR/8 w KQkq - 0 1", FenError::INVALID_RANK_COUNT, 43);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", FenError::MISSING_FIELD, 43);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1", FenError::INVALID_SIDE, 44);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkK - 0 1", FenError::INVALID_CASTLING, 46);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e4 0 1", FenError::INVALID_EN_PASSANT, 51);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - -1 1", FenError::INVALID_CLOCK, 53);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0", FenError::MISSING_FIELD, 54);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 65536", FenError::INVALID_CLOCK, 55);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1x", FenError::INVALID_CLOCK, 55);
+  expect_error("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1 ", FenError::TRAILING_CHARACTERS, 56);
+}
+
+/**
+ * @test FenTest.ConstructorThrows
+ * @brief Verifies that the string constructor reports malformed FENs with std::invalid_argument.
+ */
+TEST(FenTest, ConstructorThrows) {
+  EXPECT_THROW(Board("not a fen"), std::invalid_argument);
+  EXPECT_THROW(Board("8/8/8/8/8/8/8/8 w - - zero 1"), std::invalid_argument);
+}
+
+/**
+ * @test FenTest.CallerBuffer
+ * @brief Verifies writing into a caller buffer: exact length, null terminator if room, 0 if too small.
+ */
+TEST(FenTest, CallerBuffer) {
+  const Board board;
+  const std::string_view fen = REFERENCE_FENS[0];
+
+  char buffer[Board::MAX_FEN_LENGTH];
+  ASSERT_EQ(board.to_fen(buffer), fen.size());
+  EXPECT_EQ(std::string_view(buffer), fen);
+
+  char exact[56];
+  ASSERT_EQ(sizeof(exact), fen.size());
+  EXPECT_EQ(board.to_fen(exact), fen.size());
+  EXPECT_EQ(std::string_view(exact, sizeof(exact)), fen);
+
+  char small[55] = {};
+  EXPECT_EQ(board.to_fen(small), 0u);
+  EXPECT_EQ(small[0], '\0');
+}
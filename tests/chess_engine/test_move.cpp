@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <chess_engine/move.hpp>
+#include <chess_engine/piece.hpp>
+#include <chess_engine/square.hpp>
+
+/**
+ * @test MoveTest.FitsIn16Bits
+ * @brief Verifies that a move is stored on two bytes.
+ */
+TEST(MoveTest, FitsIn16Bits) { EXPECT_EQ(sizeof(Move), 2u); }
+
+/**
+ * @test MoveTest.NullMove
+ * @brief Verifies that the default move is the null move.
+ */
+TEST(MoveTest, NullMove) {
+  Move move;
+  EXPECT_TRUE(move.is_null());
+  EXPECT_EQ(move.raw(), 0);
+  EXPECT_FALSE(Move(Square(Square::E2), Square(Square::E4)).is_null());
+}
+
+/**
+ * @test MoveTest.PacksSquaresAndType
+ * @brief Verifies that origin, destination and type round-trip through the packed value.
+ */
+TEST(MoveTest, PacksSquaresAndType) {
+  const Move normal(Square(Square::G1), Square(Square::F3));
+  EXPECT_EQ(normal.from(), Square(Square::G1));
+  EXPECT_EQ(normal.to(), Square(Square::F3));
+  EXPECT_EQ(normal.type(), Move::NORMAL);
+
+  const Move castling(Square(Square::E8), Square(Square::C8), Move::CASTLING);
+  EXPECT_EQ(castling.from(), Square(Square::E8));
+  EXPECT_EQ(castling.to(), Square(Square::C8));
+  EXPECT_EQ(castling.type(), Move::CASTLING);
+
+  const Move en_passant(Square(Square::E5), Square(Square::D6), Move::EN_PASSANT);
+  EXPECT_EQ(en_passant.type(), Move::EN_PASSANT);
+  EXPECT_EQ(en_passant.to(), Square(Square::D6));
+}
+
+/**
+ * @test MoveTest.Promotions
+ * @brief Verifies that the promoted piece is stored independently of its color.
+ */
+TEST(MoveTest, Promotions) {
+  const Move queen = Move::make_promotion(Square(Square::E7), Square(Square::E8), Piece::Q);
+  EXPECT_EQ(queen.type(), Move::PROMOTION);
+  EXPECT_EQ(queen.promotion_type(Piece::WHITE), Piece::Q);
+  EXPECT_EQ(queen.promotion_type(Piece::BLACK), Piece::q);
+
+  const Move knight = Move::make_promotion(Square(Square::B2), Square(Square::A1), Piece::n);
+  EXPECT_EQ(knight.from(), Square(Square::B2));
+  EXPECT_EQ(knight.to(), Square(Square::A1));
+  EXPECT_EQ(knight.promotion_type(Piece::BLACK), Piece::n);
+  EXPECT_EQ(knight.promotion_type(Piece::WHITE), Piece::N);
+}
+
+/**
+ * @test MoveTest.UciNotation
+ * @brief Verifies the UCI long algebraic notation of each move type.
+ */
+TEST(MoveTest, UciNotation) {
+  EXPECT_EQ(Move(Square(Square::E2), Square(Square::E4)).to_uci(), "e2e4");
+  EXPECT_EQ(Move(Square(Square::E1), Square(Square::G1), Move::CASTLING).to_uci(), "e1g1");
+  EXPECT_EQ(Move::make_promotion(Square(Square::A7), Square(Square::B8), Piece::R).to_uci(), "a7b8r");
+  EXPECT_EQ(Move::make_promotion(Square(Square::H2), Square(Square::H1), Piece::b).to_uci(), "h2h1b");
+}
@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chess_engine/board.hpp>
+#include <chess_engine/move.hpp>
+#include <chess_engine/move_ordering.hpp>
+#include <chess_engine/movegen.hpp>
+#include <chess_engine/square.hpp>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** White to move: Qxd5 loses the queen to c6, exd5 trades pawns, and the queen has quiet moves on both sides. */
+const std::string CAPTURES = "4k3/8/2p5/3p4/4P3/8/3Q4/4K3 w - - 0 1";
+
+Move move(Square::Value from, Square::Value to, Move::Type type = Move::NORMAL) {
+  return Move(Square(from), Square(to), type);
+}
+
+Move promotion(Square::Value from, Square::Value to, Piece::Type type) {
+  return Move::make_promotion(Square(from), Square(to), type);
+}
+
+std::vector<Move> all_moves(MovePicker& picker) {
+  std::vector<Move> moves;
+  for (Move next = picker.next(); !next.is_null(); next = picker.next()) moves.push_back(next);
+  return moves;
+}
+
+/**
+ * Checks recursively that a picker returns each legal move exactly once, with history gathered along the way so
+ * that hash moves, killers and counter moves are exercised (including ones from other positions).
+ */
+void expect_picker_returns_legal_moves(Board& board, History& history, int depth, int ply, History::PieceTo previous,
+                                       Move hash_move) {
+  MoveList legal;
+  MoveGen::generate_legal(board, legal);
+  MovePicker picker(board, hash_move, &history, ply, previous);
+  const std::vector<Move> picked = all_moves(picker);
+  ASSERT_EQ(picked.size(), legal.size()) << board.to_fen();
+  for (const Move move : legal) {
+    ASSERT_EQ(std::count(picked.begin(), picked.end(), move), 1) << move.to_uci() << " in " << board.to_fen();
+  }
+
+  MovePicker captures(board);
+  for (Move move = captures.next(); !move.is_null(); move = captures.next()) {
+    ASSERT_TRUE(MoveOrdering::is_tactical(board, move)) << move.to_uci() << " in " << board.to_fen();
+  }
+
+  if (depth == 0) return;
+  Move last_quiet;
+  for (const Move move : picked) {
+    const History::PieceTo played = History::piece_to(board, move);
+    if (!MoveOrdering::is_tactical(board, move)) {
+      history.update(board, move, {}, depth, ply, previous);
+      last_quiet = move;
+    }
+    const Board::UndoInfo undo = board.make_move(move);
+    // The hash move of the child is a move of this position: mostly illegal there
+    expect_picker_returns_legal_moves(board, history, depth - 1, ply + 1, played, last_quiet);
+    board.unmake_move(move, undo);
+  }
+}
+
+}  // namespace
+
+/**
+ * @test MoveOrderingTest.TacticalMoves
+ * @brief Verifies that captures, en passant and queen promotions are tactical, unlike quiet under-promotions and
+ * castling.
+ */
+TEST(MoveOrderingTest, TacticalMoves) {
+  const Board board("r3k2r/1P6/8/3pP3/8/8/8/R3K2R w KQkq d6 0 1");
+  EXPECT_TRUE(MoveOrdering::is_tactical(board, move(Square::A1, Square::A8)));
+  EXPECT_TRUE(MoveOrdering::is_tactical(board, move(Square::E5, Square::D6, Move::EN_PASSANT)));
+  EXPECT_TRUE(MoveOrdering::is_tactical(board, promotion(Square::B7, Square::B8, Piece::Q)));
+  EXPECT_TRUE(MoveOrdering::is_tactical(board, promotion(Square::B7, Square::A8, Piece::N)));
+  EXPECT_FALSE(MoveOrdering::is_tactical(board, promotion(Square::B7, Square::B8, Piece::N)));
+  EXPECT_FALSE(MoveOrdering::is_tactical(board, move(Square::E1, Square::G1, Move::CASTLING)));
+  EXPECT_FALSE(MoveOrdering::is_tactical(board, move(Square::A1, Square::A2)));
+}
+
+/**
+ * @test MoveOrderingTest.MvvLva
+ * @brief Verifies that the most valuable victim comes first, then the least valuable attacker, and that a queen
+ * promotion adds a queen to the victim.
+ */
+TEST(MoveOrderingTest, MvvLva) {
+  const Board board("r3k2r/1P6/8/3pP3/8/8/8/R3K2R w KQkq d6 0 1");
+  const int rook_takes_rook = MoveOrdering::mvv_lva(board, move(Square::A1, Square::A8));
+  const int pawn_takes_rook = MoveOrdering::mvv_lva(board, promotion(Square::B7, Square::A8, Piece::N));
+  const int promotion_takes_rook = MoveOrdering::mvv_lva(board, promotion(Square::B7, Square::A8, Piece::Q));
+  const int pawn_takes_pawn = MoveOrdering::mvv_lva(board, move(Square::E5, Square::D6, Move::EN_PASSANT));
+  const int quiet_promotion = MoveOrdering::mvv_lva(board, promotion(Square::B7, Square::B8, Piece::Q));
+  EXPECT_GT(promotion_takes_rook, pawn_takes_rook);
+  EXPECT_GT(pawn_takes_rook, rook_takes_rook);
+  EXPECT_GT(rook_takes_rook, pawn_takes_pawn);
+  EXPECT_GT(quiet_promotion, rook_takes_rook);
+  EXPECT_LT(promotion_takes_rook, 128);
+}
+
+/**
+ * @test MoveOrderingTest.SeeBands
+ * @brief Verifies that an equal trade ranks in the good capture band and a capture losing the queen in the bad
+ * one, below every quiet move score.
+ */
+TEST(MoveOrderingTest, SeeBands) {
+  const Board board(CAPTURES);
+  const int trade = MoveOrdering::tactical_score(board, move(Square::E4, Square::D5));
+  const int losing = MoveOrdering::tactical_score(board, move(Square::D2, Square::D5));
+  EXPECT_GE(trade, MoveOrdering::GOOD_CAPTURE_SCORE);
+  EXPECT_LT(trade, MoveOrdering::KILLER_SCORE + MoveOrdering::GOOD_CAPTURE_SCORE);
+  EXPECT_GE(losing, MoveOrdering::BAD_CAPTURE_SCORE);
+  EXPECT_LT(losing, -2 * MoveOrdering::HISTORY_MAX);
+}
+
+/**
+ * @test MoveOrderingTest.Bands
+ * @brief Verifies the full order and its stages: hash move, good capture, killers (most recent first), counter
+ * move, quiet moves by history (rewarded first, penalized last), losing capture.
+ */
+TEST(MoveOrderingTest, Bands) {
+  const Board board(CAPTURES);
+  MoveList legal;
+  MoveGen::generate_legal(board, legal);
+
+  const History::PieceTo previous{Piece::p, Square(Square::C6)};
+  const auto history = std::make_unique<History>();
+  history->update(board, move(Square::D2, Square::H6), {}, 3, 2, {});
+  history->update(board, move(Square::D2, Square::G5), {}, 3, 2, {});
+  const Move penalized = move(Square::D2, Square::D3);
+  history->update(board, move(Square::E1, Square::D1), std::span(&penalized, 1), 3, 5, previous);
+  history->update(board, move(Square::E4, Square::E5), {}, 3, 7, {});
+  EXPECT_EQ(history->killer(2, 0), move(Square::D2, Square::G5));
+  EXPECT_EQ(history->killer(2, 1), move(Square::D2, Square::H6));
+  EXPECT_EQ(history->counter_move(previous), move(Square::E1, Square::D1));
+  EXPECT_TRUE(history->counter_move({}).is_null());
+
+  MovePicker picker(board, move(Square::E1, Square::F1), history.get(), 2, previous);
+  EXPECT_EQ(picker.next(), move(Square::E1, Square::F1));
+  EXPECT_EQ(picker.stage(), MovePicker::GENERATE_CAPTURES);
+  EXPECT_EQ(picker.next(), move(Square::E4, Square::D5));
+  EXPECT_EQ(picker.stage(), MovePicker::GOOD_CAPTURES);
+  EXPECT_EQ(picker.next(), move(Square::D2, Square::G5));
+  EXPECT_EQ(picker.stage(), MovePicker::REFUTATIONS);
+  EXPECT_EQ(picker.next(), move(Square::D2, Square::H6));
+  EXPECT_EQ(picker.next(), move(Square::E1, Square::D1));
+  EXPECT_EQ(picker.stage(), MovePicker::REFUTATIONS);
+  EXPECT_EQ(picker.next(), move(Square::E4, Square::E5));
+  EXPECT_EQ(picker.stage(), MovePicker::QUIETS);
+
+  const std::vector<Move> rest = all_moves(picker);
+  EXPECT_EQ(picker.stage(), MovePicker::DONE);
+  ASSERT_EQ(rest.size() + 6, legal.size());
+  EXPECT_EQ(rest[rest.size() - 2], penalized);
+  EXPECT_EQ(rest.back(), move(Square::D2, Square::D5));
+  EXPECT_TRUE(picker.next().is_null());
+
+  // Captures only: the good one, then the losing one
+  MovePicker captures(board);
+  EXPECT_EQ(captures.next(), move(Square::E4, Square::D5));
+  EXPECT_EQ(captures.next(), move(Square::D2, Square::D5));
+  EXPECT_TRUE(captures.next().is_null());
+}
+
+/**
+ * @test MoveOrderingTest.PickerValidatesMoves
+ * @brief Verifies that an illegal hash move and killers that are illegal or captures in this position are
+ * skipped, and that a hash move found again by generation is not returned twice.
+ */
+TEST(MoveOrderingTest, PickerValidatesMoves) {
+  const Board board(CAPTURES);
+  MoveList legal;
+  MoveGen::generate_legal(board, legal);
+
+  const History::PieceTo previous{Piece::p, Square(Square::C6)};
+  const auto history = std::make_unique<History>();
+  history->update(board, move(Square::D2, Square::A5), {}, 3, 4, previous);
+  history->update(board, move(Square::D2, Square::D5), {}, 3, 1, {});  // a capture here
+  const Board other("4k3/8/8/8/8/8/8/R3K3 w - - 0 1");
+  history->update(other, move(Square::A1, Square::A8), {}, 3, 1, {});  // no rook here
+  EXPECT_EQ(history->killer(1, 0), move(Square::A1, Square::A8));
+  EXPECT_EQ(history->killer(1, 1), move(Square::D2, Square::D5));
+
+  // Both killers are skipped, the counter move is not
+  MovePicker illegal_hash(board, move(Square::E1, Square::E3), history.get(), 1, previous);
+  EXPECT_EQ(illegal_hash.next(), move(Square::E4, Square::D5));
+  EXPECT_EQ(illegal_hash.next(), move(Square::D2, Square::A5));
+  EXPECT_EQ(illegal_hash.stage(), MovePicker::REFUTATIONS);
+  EXPECT_EQ(all_moves(illegal_hash).size() + 2, legal.size());
+
+  MovePicker capture_hash(board, move(Square::D2, Square::D5), history.get(), 1, previous);
+  const std::vector<Move> picked = all_moves(capture_hash);
+  EXPECT_EQ(picked.front(), move(Square::D2, Square::D5));
+  EXPECT_EQ(picked.size(), legal.size());
+  EXPECT_EQ(std::count(picked.begin(), picked.end(), move(Square::D2, Square::D5)), 1);
+}
+
+/**
+ * @test MoveOrderingTest.PickerReturnsEachLegalMoveOnce
+ * @brief Verifies on a search tree that the picker returns every legal move exactly once, whatever the hash move,
+ * killers and counter moves, and that the captures-only picker returns tactical moves only.
+ */
+TEST(MoveOrderingTest, PickerReturnsEachLegalMoveOnce) {
+  for (const char* fen : {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                          "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+                          "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1"}) {
+    Board board(fen);
+    const auto history = std::make_unique<History>();
+    expect_picker_returns_legal_moves(board, *history, 2, 0, {}, Move());
+  }
+}
+
+/**
+ * @test MoveOrderingTest.HistoryIsBounded
+ * @brief Verifies that repeated bonuses and maluses saturate within the history bounds, and that clear() forgets
+ * everything.
+ */
+TEST(MoveOrderingTest, HistoryIsBounded) {
+  const Board board(CAPTURES);
+  const History::PieceTo previous{Piece::p, Square(Square::C6)};
+  const Move best = move(Square::D2, Square::H6);
+  const Move tried = move(Square::D2, Square::A5);
+  const auto history = std::make_unique<History>();
+  for (int i = 0; i < 1000; ++i) history->update(board, best, std::span(&tried, 1), 20, 1, previous);
+
+  const int high = history->quiet_score(board, best, previous);
+  const int low = history->quiet_score(board, tried, previous);
+  EXPECT_GT(high, MoveOrdering::HISTORY_MAX);
+  EXPECT_LE(high, 2 * MoveOrdering::HISTORY_MAX);
+  EXPECT_LT(low, -MoveOrdering::HISTORY_MAX);
+  EXPECT_GE(low, -2 * MoveOrdering::HISTORY_MAX);
+
+  history->clear();
+  EXPECT_EQ(history->quiet_score(board, best, previous), 0);
+  EXPECT_TRUE(history->killer(1, 0).is_null());
+  EXPECT_TRUE(history->counter_move(previous).is_null());
+}
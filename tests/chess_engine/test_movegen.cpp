@@ -0,0 +1,395 @@
+#include <gtest/gtest.h>
+
+#include <chess_engine/board.hpp>
+#include <chess_engine/move.hpp>
+#include <chess_engine/move_ordering.hpp>
+#include <chess_engine/movegen.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Counts leaf nodes by generating pseudo-legal moves and discarding those leaving the king in check.
+ */
+uint64_t pseudo_legal_perft(Board& board, int depth) {
+  if (depth == 0) return 1;
+
+  MoveList moves;
+  MoveGen::generate_pseudo_legal(board, moves);
+
+  uint64_t nodes = 0;
+  const Piece::Color us = board.side_to_move();
+  const Piece::Color them = us == Piece::WHITE ? Piece::BLACK : Piece::WHITE;
+  for (const Move move : moves) {
+    const Board::UndoInfo undo = board.make_move(move);
+    if (!board.is_square_attacked(board.king_square(us), them)) {
+      nodes += pseudo_legal_perft(board, depth - 1);
+    }
+    board.unmake_move(move, undo);
+  }
+  return nodes;
+}
+
+Move move(Square::Value from, Square::Value to, Move::Type type = Move::NORMAL) {
+  return Move(Square(from), Square(to), type);
+}
+
+}  // namespace
+
+/**
+ * @test MoveGenTest.StartingPosition
+ * @brief Verifies the 20 moves of the starting position: 16 pawn moves and 4 knight moves.
+ */
+TEST(MoveGenTest, StartingPosition) {
+  Board board;
+  MoveList moves;
+  MoveGen::generate_pseudo_legal(board, moves);
+
+  EXPECT_EQ(moves.size(), 20u);
+  EXPECT_TRUE(moves.contains(move(Square::E2, Square::E4)));
+  EXPECT_TRUE(moves.contains(move(Square::A2, Square::A3)));
+  EXPECT_TRUE(moves.contains(move(Square::G1, Square::F3)));
+  EXPECT_FALSE(moves.contains(move(Square::F1, Square::C4)));
+}
+
+/**
+ * @test MoveGenTest.Promotions
+ * @brief Verifies that pushes and captures onto the last rank produce all four promotions.
+ */
+TEST(MoveGenTest, Promotions) {
+  Board board("1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1");
+  MoveList moves;
+  MoveGen::generate_pseudo_legal(board, moves);
+
+  for (Piece::Type promotion : {Piece::Q, Piece::R, Piece::B, Piece::N}) {
+    EXPECT_TRUE(moves.contains(Move::make_promotion(Square(Square::A7), Square(Square::A8), promotion)));
+    EXPECT_TRUE(moves.contains(Move::make_promotion(Square(Square::A7), Square(Square::B8), promotion)));
+  }
+  EXPECT_FALSE(moves.contains(move(Square::A7, Square::A8)));
+}
+
+/**
+ * @test MoveGenTest.EnPassant
+ * @brief Verifies that both pawns next to the double-pushed pawn can take en passant.
+ */
+TEST(MoveGenTest, EnPassant) {
+  Board board("4k3/8/8/2PpP3/8/8/8/4K3 w - d6 0 1");
+  MoveList moves;
+  MoveGen::generate_pseudo_legal(board, moves);
+
+  EXPECT_TRUE(moves.contains(move(Square::C5, Square::D6, Move::EN_PASSANT)));
+  EXPECT_TRUE(moves.contains(move(Square::E5, Square::D6, Move::EN_PASSANT)));
+}
+
+/**
+ * @test MoveGenTest.Castling
+ * @brief Verifies castling generation: allowed, blocked by a piece, and forbidden through an attacked square.
+ */
+TEST(MoveGenTest, Castling) {
+  {
+    Board board("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    MoveList moves;
+    MoveGen::generate_pseudo_legal(board, moves);
+    EXPECT_TRUE(moves.contains(move(Square::E1, Square::G1, Move::CASTLING)));
+    EXPECT_TRUE(moves.contains(move(Square::E1, Square::C1, Move::CASTLING)));
+  }
+  {
+    // Knight on b1 blocks queenside, rook on f8 attacks f1
+    Board board("r3kr2/8/8/8/8/8/8/RN2K2R w KQ - 0 1");
+    MoveList moves;
+    MoveGen::generate_pseudo_legal(board, moves);
+    EXPECT_FALSE(moves.contains(move(Square::E1, Square::G1, Move::CASTLING)));
+    EXPECT_FALSE(moves.contains(move(Square::E1, Square::C1, Move::CASTLING)));
+  }
+  {
+    // No castling out of check
+    Board board("r3k2r/8/8/8/8/8/4q3/R3K2R w KQ - 0 1");
+    MoveList moves;
+    MoveGen::generate_pseudo_legal(board, moves);
+    EXPECT_FALSE(moves.contains(move(Square::E1, Square::G1, Move::CASTLING)));
+    EXPECT_FALSE(moves.contains(move(Square::E1, Square::C1, Move::CASTLING)));
+  }
+}
+
+/**
+ * @test MoveGenTest.PerftReferencePositions
+ * @brief Verifies node counts of the standard perft positions, filtering pseudo-legal moves with make/unmake.
+ *
+ * @see https://www.chessprogramming.org/Perft_Results
+ */
+TEST(MoveGenTest, PerftReferencePositions) {
+  struct Case {
+    std::string fen;
+    int depth;
+    uint64_t nodes;
+  };
+  const Case cases[] = {
+      {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 3, 8902},
+      {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3, 97862},
+      {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4, 43238},
+      {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3, 9467},
+      {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3, 62379},
+      {"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 3, 89890},
+  };
+
+  for (const Case& c : cases) {
+    Board board(c.fen);
+    EXPECT_EQ(pseudo_legal_perft(board, c.depth), c.nodes) << c.fen;
+    EXPECT_EQ(board.hash(), Board(c.fen).hash()) << "position not restored: " << c.fen;
+  }
+}
+
+namespace {
+
+uint64_t legal_perft(Board& board, int depth) {
+  MoveList moves;
+  MoveGen::generate_legal(board, moves);
+  if (depth == 1) return moves.size();
+
+  uint64_t nodes = 0;
+  for (const Move move : moves) {
+    const Board::UndoInfo undo = board.make_move(move);
+    nodes += legal_perft(board, depth - 1);
+    board.unmake_move(move, undo);
+  }
+  return nodes;
+}
+
+/**
+ * @brief Checks that the legal generator yields exactly the pseudo-legal moves not leaving the king in check,
+ * in this position and every position reachable within `depth` plies.
+ */
+void expect_legal_matches_filtered(Board& board, int depth) {
+  MoveList pseudo_legal;
+  MoveGen::generate_pseudo_legal(board, pseudo_legal);
+  MoveList legal;
+  MoveGen::generate_legal(board, legal);
+
+  const Piece::Color us = board.side_to_move();
+  const Piece::Color them = us == Piece::WHITE ? Piece::BLACK : Piece::WHITE;
+  std::size_t expected = 0;
+  for (const Move move : pseudo_legal) {
+    const Board::UndoInfo undo = board.make_move(move);
+    const bool is_legal = !board.is_square_attacked(board.king_square(us), them);
+    board.unmake_move(move, undo);
+    if (is_legal) {
+      ++expected;
+      ASSERT_TRUE(legal.contains(move)) << "missing " << move.to_uci();
+    }
+  }
+  ASSERT_EQ(legal.size(), expected);
+
+  if (depth == 0) return;
+  for (const Move move : legal) {
+    const Board::UndoInfo undo = board.make_move(move);
+    expect_legal_matches_filtered(board, depth - 1);
+    board.unmake_move(move, undo);
+  }
+}
+
+/**
+ * @brief Checks recursively that captures and quiet moves split the legal moves in two, along MoveOrdering's
+ * notion of tactical moves.
+ */
+void expect_split_matches_legal(Board& board, int depth) {
+  MoveList legal;
+  MoveGen::generate_legal(board, legal);
+  MoveList captures;
+  MoveGen::generate_captures(board, captures);
+  MoveList quiets;
+  MoveGen::generate_quiets(board, quiets);
+
+  ASSERT_EQ(captures.size() + quiets.size(), legal.size()) << board.to_fen();
+  for (const Move move : captures) {
+    ASSERT_TRUE(legal.contains(move)) << "illegal capture " << move.to_uci() << " in " << board.to_fen();
+    ASSERT_TRUE(MoveOrdering::is_tactical(board, move)) << move.to_uci() << " in " << board.to_fen();
+  }
+  for (const Move move : quiets) {
+    ASSERT_TRUE(legal.contains(move)) << "illegal quiet " << move.to_uci() << " in " << board.to_fen();
+    ASSERT_FALSE(MoveOrdering::is_tactical(board, move)) << move.to_uci() << " in " << board.to_fen();
+  }
+
+  if (depth == 0) return;
+  for (const Move move : legal) {
+    const Board::UndoInfo undo = board.make_move(move);
+    expect_split_matches_legal(board, depth - 1);
+    board.unmake_move(move, undo);
+  }
+}
+
+}  // namespace
+
+/**
+ * @test MoveGenTest.LegalPerftReferencePositions
+ * @brief Verifies node counts of the standard perft positions with the legal generator, one ply deeper.
+ */
+TEST(MoveGenTest, LegalPerftReferencePositions) {
+  struct Case {
+    std::string fen;
+    int depth;
+    uint64_t nodes;
+  };
+  const Case cases[] = {
+      {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 4, 197281},
+      {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3, 97862},
+      {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5, 674624},
+      {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, 422333},
+      {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3, 62379},
+      {"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 3, 89890},
+  };
+
+  for (const Case& c : cases) {
+    Board board(c.fen);
+    EXPECT_EQ(legal_perft(board, c.depth), c.nodes) << c.fen;
+  }
+}
+
+/**
+ * @test MoveGenTest.LegalMatchesFilteredPseudoLegal
+ * @brief Verifies that legal moves are exactly the pseudo-legal moves that do not leave the king in check.
+ */
+TEST(MoveGenTest, LegalMatchesFilteredPseudoLegal) {
+  for (const char* fen : {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                          "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+                          "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"}) {
+    Board board(fen);
+    expect_legal_matches_filtered(board, 2);
+  }
+}
+
+/**
+ * @test MoveGenTest.LegalChecksAndPins
+ * @brief Verifies evasions in single and double check, and moves of pinned pieces.
+ */
+TEST(MoveGenTest, LegalChecksAndPins) {
+  {
+    // Rook check on the e-file: block on e2..e7, capture on e8 impossible, king steps aside
+    Board board("4r1k1/8/8/8/8/8/3B4/4K3 w - - 0 1");
+    MoveList moves;
+    MoveGen::generate_legal(board, moves);
+    EXPECT_TRUE(moves.contains(move(Square::D2, Square::E3)));
+    EXPECT_FALSE(moves.contains(move(Square::D2, Square::C3)));
+    EXPECT_FALSE(moves.contains(move(Square::E1, Square::E2)));  // still on the checking line
+    EXPECT_TRUE(moves.contains(move(Square::E1, Square::D1)));
+  }
+  {
+    // Double check by rook and knight: only king moves
+    Board board("4r1k1/8/8/8/8/3n4/3B4/4K3 w - - 0 1");
+    MoveList moves;
+    MoveGen::generate_legal(board, moves);
+    for (const Move m : moves) EXPECT_EQ(m.from(), Square(Square::E1)) << m.to_uci();
+  }
+  {
+    // Bishop pinned on the e-file cannot move
+    Board board("4r1k1/8/8/8/8/8/4B3/4K3 w - - 0 1");
+    MoveList moves;
+    MoveGen::generate_legal(board, moves);
+    EXPECT_FALSE(moves.contains(move(Square::E2, Square::D3)));
+    EXPECT_FALSE(moves.contains(move(Square::E2, Square::F1)));
+  }
+  {
+    // Two pieces on the line: neither is pinned
+    Board board("4r1k1/8/8/8/4R3/8/4B3/4K3 w - - 0 1");
+    MoveList moves;
+    MoveGen::generate_legal(board, moves);
+    EXPECT_TRUE(moves.contains(move(Square::E2, Square::D3)));
+    EXPECT_TRUE(moves.contains(move(Square::E4, Square::D4)));
+  }
+  {
+    // Rook pinned on the e-file slides along it, up to capturing the pinner
+    Board board("4r1k1/8/8/8/4R3/8/8/4K3 w - - 0 1");
+    MoveList moves;
+    MoveGen::generate_legal(board, moves);
+    EXPECT_TRUE(moves.contains(move(Square::E4, Square::E8)));
+    EXPECT_TRUE(moves.contains(move(Square::E4, Square::E2)));
+    EXPECT_FALSE(moves.contains(move(Square::E4, Square::A4)));
+  }
+}
+
+/**
+ * @test MoveGenTest.LegalEnPassantEdgeCases
+ * @brief Verifies en passant with a horizontal discovered check, a diagonal pin, and capturing the checker.
+ */
+TEST(MoveGenTest, LegalEnPassantEdgeCases) {
+  {
+    // Both pawns leave the fifth rank at once, exposing the king to the rook
+    Board board("8/8/8/K2pP2r/8/8/8/7k w - d6 0 1");
+    MoveList moves;
+    MoveGen::generate_legal(board, moves);
+    EXPECT_FALSE(moves.contains(move(Square::E5, Square::D6, Move::EN_PASSANT)));
+  }
+  {
+    // Capturing pawn pinned diagonally, the capture leaves the pin line
+    Board board("7k/6b1/8/3pP3/3K4/8/8/8 w - d6 0 1");
+    MoveList moves;
+    MoveGen::generate_legal(board, moves);
+    EXPECT_FALSE(moves.contains(move(Square::E5, Square::D6, Move::EN_PASSANT)));
+  }
+  {
+    // Capturing pawn pinned diagonally, the capture stays on the pin line
+    Board board("7k/2b5/8/3pP3/5K2/8/8/8 w - d6 0 1");
+    MoveList moves;
+    MoveGen::generate_legal(board, moves);
+    EXPECT_TRUE(moves.contains(move(Square::E5, Square::D6, Move::EN_PASSANT)));
+  }
+  {
+    // The double-pushed pawn gives check and can be taken en passant
+    Board board("8/8/8/5k2/3pP3/8/8/4K3 b - e3 0 1");
+    MoveList moves;
+    MoveGen::generate_legal(board, moves);
+    EXPECT_TRUE(moves.contains(move(Square::D4, Square::E3, Move::EN_PASSANT)));
+  }
+}
+
+/**
+ * @test MoveGenTest.CapturesAndQuietsSplitLegal
+ * @brief Verifies that capture and quiet generation return disjoint sets of legal moves covering all of them,
+ * through checks, pins, promotions, en passant and castling.
+ */
+TEST(MoveGenTest, CapturesAndQuietsSplitLegal) {
+  for (const char* fen : {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                          "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+                          "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+                          "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1"}) {
+    Board board(fen);
+    expect_split_matches_legal(board, 2);
+  }
+}
+
+/**
+ * @test MoveGenTest.IsLegalMatchesGeneration
+ * @brief Verifies that is_legal() accepts exactly the generated legal moves among all 65536 move values, in
+ * positions with castling, en passant, promotions, pins and checks, and in their children.
+ */
+TEST(MoveGenTest, IsLegalMatchesGeneration) {
+  for (const char* fen : {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                          "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+                          "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1", "8/8/8/K2pP2r/8/8/8/7k w - d6 0 1",
+                          "7k/2b5/8/3pP3/5K2/8/8/8 w - d6 0 1", "8/8/8/5k2/3pP3/8/8/4K3 b - e3 0 1",
+                          "4r1k1/8/8/8/8/8/3B4/4K3 w - - 0 1", "4k3/8/8/8/8/5n2/4r3/R3K2R w KQ - 0 1"}) {
+    // The position and all the positions one move later
+    const Board root(fen);
+    std::vector<Board> boards = {root};
+    MoveList root_moves;
+    MoveGen::generate_legal(root, root_moves);
+    for (const Move move : root_moves) {
+      boards.push_back(root);
+      boards.back().make_move(move);
+    }
+
+    for (const Board& board : boards) {
+      MoveList legal;
+      MoveGen::generate_legal(board, legal);
+      int accepted = 0;
+      for (uint32_t raw = 0; raw <= UINT16_MAX; ++raw) {
+        const Move move = Move::from_raw(static_cast<uint16_t>(raw));
+        const bool is_legal = MoveGen::is_legal(board, move);
+        accepted += is_legal;
+        ASSERT_EQ(is_legal, legal.contains(move)) << move.to_uci() << " in " << board.to_fen();
+      }
+      EXPECT_EQ(accepted, static_cast<int>(legal.size())) << board.to_fen();
+    }
+  }
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <chess_engine/board.hpp>
+#include <chess_engine/perft.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Reference position with its expected leaf count at a given depth.
+ */
+struct PerftCase {
+  std::string name;
+  std::string fen;
+  int depth;
+  uint64_t nodes;
+};
+
+/**
+ * Standard perft positions, at depths that finish within a few seconds.
+ * @see https://www.chessprogramming.org/Perft_Results
+ */
+const PerftCase PERFT_CASES[] = {
+    {"StartPosition", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609},
+    {"Kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603},
+    {"Position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083},
+    {"Position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, 422333},
+    {"Position4Mirrored", "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1", 4, 422333},
+    {"Position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487},
+    {"Position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594},
+};
+
+class PerftTest : public ::testing::TestWithParam<PerftCase> {};
+
+}  // namespace
+
+/**
+ * @test PerftTest.ReferenceNodeCount
+ * @brief Verifies the leaf count of a reference position, and that the position is restored afterwards.
+ */
+TEST_P(PerftTest, ReferenceNodeCount) {
+  const PerftCase& c = GetParam();
+  Board board(c.fen);
+  EXPECT_EQ(Perft::perft(board, c.depth), c.nodes);
+  EXPECT_EQ(board.hash(), Board(c.fen).hash());
+}
+
+INSTANTIATE_TEST_SUITE_P(ReferencePositions, PerftTest, ::testing::ValuesIn(PERFT_CASES),
+                         [](const ::testing::TestParamInfo<PerftCase>& info) { return info.param.name; });
+
+/**
+ * @test PerftDivideTest.SumsToPerft
+ * @brief Verifies that divide yields one entry per legal root move and that the entries sum up to perft.
+ */
+TEST(PerftDivideTest, SumsToPerft) {
+  Board board(PERFT_CASES[1].fen);
+  const std::vector<Perft::DivideEntry> entries = Perft::divide(board, 3);
+  EXPECT_EQ(entries.size(), 48u);
+
+  uint64_t total = 0;
+  for (const Perft::DivideEntry& entry : entries) total += entry.nodes;
+  EXPECT_EQ(total, 97862u);
+}
+
+/**
+ * @test PerftDivideTest.ShallowDepths
+ * @brief Verifies the degenerate depths: depth 0 counts the root, depth 1 counts the legal moves.
+ */
+TEST(PerftDivideTest, ShallowDepths) {
+  Board board;
+  EXPECT_EQ(Perft::perft(board, 0), 1u);
+  EXPECT_EQ(Perft::perft(board, 1), 20u);
+  for (const Perft::DivideEntry& entry : Perft::divide(board, 1)) EXPECT_EQ(entry.nodes, 1u);
+}
+
+/**
+ * @test PerftHashTableTest.StoreAndProbe
+ * @brief Verifies that entries are found by (key, depth) only, and that clear empties the table.
+ */
+TEST(PerftHashTableTest, StoreAndProbe) {
+  PerftHashTable table(1);
+  EXPECT_EQ(table.size(), (1u << 20) / 16);
+
+  uint64_t nodes = 0;
+  table.store(0x0123456789ABCDEFULL, 5, 4865609);
+  ASSERT_TRUE(table.probe(0x0123456789ABCDEFULL, 5, nodes));
+  EXPECT_EQ(nodes, 4865609u);
+  EXPECT_FALSE(table.probe(0x0123456789ABCDEFULL, 4, nodes));
+  EXPECT_FALSE(table.probe(0x0123456789ABCDEEULL, 5, nodes));
+
+  table.clear();
+  EXPECT_FALSE(table.probe(0x0123456789ABCDEFULL, 5, nodes));
+}
+
+/**
+ * @test PerftParallelTest.MatchesSerialDivide
+ * @brief Verifies that threaded divide, with and without the shared cache, matches the serial counts move by move.
+ */
+TEST(PerftParallelTest, MatchesSerialDivide) {
+  for (const PerftCase& c : PERFT_CASES) {
+    const int depth = c.depth - 1;
+    Board board(c.fen);
+    const std::vector<Perft::DivideEntry> expected = Perft::divide(board, depth);
+
+    for (unsigned threads : {1u, 4u}) {
+      PerftHashTable table(4);
+      Perft::HashStats stats;
+      for (PerftHashTable* t : {static_cast<PerftHashTable*>(nullptr), &table}) {
+        const std::vector<Perft::DivideEntry> entries = Perft::divide(board, depth, threads, t, &stats);
+        ASSERT_EQ(entries.size(), expected.size()) << c.name;
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+          EXPECT_EQ(entries[i].move, expected[i].move) << c.name;
+          EXPECT_EQ(entries[i].nodes, expected[i].nodes) << c.name << " " << entries[i].move.to_uci();
+        }
+      }
+      EXPECT_LE(stats.hits, stats.probes);
+    }
+  }
+}
+
+/**
+ * @test PerftParallelTest.CacheHitsTranspositions
+ * @brief Verifies that a second run on a warm cache answers from the table and still gets the reference count.
+ *
+ * A few entries are lost to index collisions (entries are always replaced), hence the tolerance.
+ */
+TEST(PerftParallelTest, CacheHitsTranspositions) {
+  const PerftCase& c = PERFT_CASES[1];
+  Board board(c.fen);
+  PerftHashTable table(16);
+
+  Perft::HashStats cold;
+  uint64_t total = 0;
+  for (const Perft::DivideEntry& entry : Perft::divide(board, c.depth, 4, &table, &cold)) total += entry.nodes;
+  EXPECT_EQ(total, c.nodes);
+  EXPECT_GT(cold.hits, 0u);
+
+  Perft::HashStats warm;
+  total = 0;
+  for (const Perft::DivideEntry& entry : Perft::divide(board, c.depth, 4, &table, &warm)) total += entry.nodes;
+  EXPECT_EQ(total, c.nodes);
+  EXPECT_GT(warm.hits, warm.probes * 99 / 100);
+}
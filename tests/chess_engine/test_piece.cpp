@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <chess_engine/piece.hpp>
+#include <cctype>
+#include <optional>
 #include <stdexcept>
+#include <string>
 
 TEST(PieceTest, DefaultConstructor) {
   Piece p;
@@ -62,4 +65,36 @@ TEST(PieceTest, EqualityOperators) {
 TEST(PieceTest, InvalidCharThrows) {
   EXPECT_THROW(Piece('x'), std::invalid_argument);
   EXPECT_THROW(Piece('1'), std::invalid_argument);
-}
\ No newline at end of file
+}
+
+TEST(PieceTest, OneByteEncoding) {
+  static_assert(sizeof(Piece) == 1);
+  static_assert(Piece('q').type() == Piece::q);  // the lookup tables are usable at compile time
+  EXPECT_EQ(sizeof(Piece::Type), 1u);
+}
+
+TEST(PieceTest, KindAndColor) {
+  for (int type = Piece::P; type <= Piece::K; ++type) {
+    const Piece white(static_cast<Piece::Type>(type));
+    const Piece black = Piece::make(Piece::BLACK, static_cast<Piece::Type>(type));
+    EXPECT_EQ(white.kind(), type);
+    EXPECT_EQ(black.kind(), type);
+    EXPECT_EQ(white.color(), Piece::WHITE);
+    EXPECT_EQ(black.color(), Piece::BLACK);
+    EXPECT_EQ(Piece::make(Piece::WHITE, static_cast<Piece::Type>(type)), white);
+    EXPECT_EQ(black.to_char(), std::tolower(white.to_char()));
+  }
+  EXPECT_EQ(Piece().kind(), Piece::NO_PIECE);
+}
+
+TEST(PieceTest, FromCharDoesNotThrow) {
+  for (const char c : std::string("PNBRQKpnbrqk.")) {
+    const std::optional<Piece> piece = Piece::from_char(c);
+    ASSERT_TRUE(piece.has_value());
+    EXPECT_EQ(*piece, Piece(c));
+    EXPECT_EQ(piece->to_char(), c);
+  }
+  EXPECT_FALSE(Piece::from_char('x').has_value());
+  EXPECT_FALSE(Piece::from_char('\0').has_value());
+  EXPECT_FALSE(Piece::from_char(static_cast<char>(0xE9)).has_value());
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+
+#include <chess_engine/board.hpp>
+#include <chess_engine/movegen.hpp>
+#include <chess_engine/search.hpp>
+#include <chess_engine/transposition_table.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+Search::Limits depth_limit(int depth) {
+  Search::Limits limits;
+  limits.depth = depth;
+  return limits;
+}
+
+/** Checks that a line is a sequence of legal moves from a position. */
+bool is_legal_line(Board board, const std::vector<Move>& line) {
+  for (const Move move : line) {
+    MoveList moves;
+    MoveGen::generate_legal(board, moves);
+    if (!moves.contains(move)) return false;
+    board.make_move(move);
+  }
+  return true;
+}
+
+}  // namespace
+
+/**
+ * @test SearchTest.MateInOne
+ * @brief Verifies that a back-rank mate is found and scored as a mate in one ply.
+ */
+TEST(SearchTest, MateInOne) {
+  const Board board("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+  const Search::Result result = Search::search(board, depth_limit(3));
+  EXPECT_EQ(result.best_move.to_uci(), "a1a8");
+  EXPECT_EQ(result.score, Search::VALUE_MATE - 1);
+  EXPECT_TRUE(Search::is_mate_score(result.score));
+}
+
+/**
+ * @test SearchTest.WinsMaterial
+ * @brief Verifies that an undefended queen is taken, and a defended one is left alone.
+ */
+TEST(SearchTest, WinsMaterial) {
+  const Board hanging("4k3/8/8/3q4/8/8/3R4/4K3 w - - 0 1");
+  EXPECT_EQ(Search::search(hanging, depth_limit(2)).best_move.to_uci(), "d2d5");
+
+  // Rxd5 exd5 trades a rook for a queen; Rxd5 is still best, but only by the exchange balance
+  const Board defended("4k3/8/4p3/3q4/8/8/3R4/4K3 w - - 0 1");
+  const Search::Result result = Search::search(defended, depth_limit(3));
+  EXPECT_EQ(result.best_move.to_uci(), "d2d5");
+  EXPECT_LT(result.score, 900);
+}
+
+/**
+ * @test SearchTest.NoLegalMove
+ * @brief Verifies that a mated or stalemated root returns the null move with a mate or draw score.
+ */
+TEST(SearchTest, NoLegalMove) {
+  const Search::Result mated = Search::search(Board("R5k1/5ppp/8/8/8/8/8/6K1 b - - 0 1"), depth_limit(3));
+  EXPECT_TRUE(mated.best_move.is_null());
+  EXPECT_EQ(mated.score, -Search::VALUE_MATE);
+
+  const Search::Result stalemate = Search::search(Board("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1"), depth_limit(3));
+  EXPECT_TRUE(stalemate.best_move.is_null());
+  EXPECT_EQ(stalemate.score, 0);
+}
+
+/**
+ * @test SearchTest.RepetitionIsDraw
+ * @brief Verifies that the losing side heads for a position of the game history to draw by repetition.
+ */
+TEST(SearchTest, RepetitionIsDraw) {
+  const Board board("7k/7r/8/8/8/8/8/K7 w - - 10 40");
+  const Search::Result lost = Search::search(board, depth_limit(3));
+  EXPECT_LT(lost.score, -300);
+
+  // The position after Kb1 already occurred four plies before it
+  const std::vector<uint64_t> history = {Board("7k/7r/8/8/8/8/8/1K6 b - - 8 39").hash(), 1, 2};
+  const Search::Result drawn = Search::search(board, depth_limit(3), {}, history);
+  EXPECT_EQ(drawn.best_move.to_uci(), "a1b1");
+  EXPECT_EQ(drawn.score, 0);
+}
+
+/**
+ * @test SearchTest.IterativeDeepening
+ * @brief Verifies one report per iteration up to the depth limit, each with a legal principal variation.
+ */
+TEST(SearchTest, IterativeDeepening) {
+  const Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+  std::vector<Search::Info> reports;
+  const Search::Result result =
+      Search::search(board, depth_limit(4), [&reports](const Search::Info& info) { reports.push_back(info); });
+
+  ASSERT_EQ(reports.size(), 4u);
+  for (std::size_t i = 0; i < reports.size(); ++i) {
+    EXPECT_EQ(reports[i].depth, static_cast<int>(i) + 1);
+    EXPECT_FALSE(reports[i].pv.empty());
+    EXPECT_TRUE(is_legal_line(board, reports[i].pv));
+    if (i > 0) {
+      EXPECT_GT(reports[i].nodes, reports[i - 1].nodes);
+    }
+  }
+  EXPECT_EQ(result.depth, 4);
+  EXPECT_EQ(result.pv, reports.back().pv);
+  EXPECT_EQ(result.best_move, result.pv.front());
+  EXPECT_EQ(result.score, reports.back().score);
+}
+
+/**
+ * @test SearchTest.NodeAndTimeLimits
+ * @brief Verifies that the node and time budgets stop the search, which still returns a legal move.
+ */
+TEST(SearchTest, NodeAndTimeLimits) {
+  const Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+  MoveList legal;
+  MoveGen::generate_legal(board, legal);
+
+  Search::Limits nodes;
+  nodes.nodes = 20000;
+  const Search::Result by_nodes = Search::search(board, nodes);
+  EXPECT_LE(by_nodes.nodes, nodes.nodes);
+  EXPECT_GE(by_nodes.depth, 1);
+  EXPECT_TRUE(legal.contains(by_nodes.best_move));
+
+  Search::Limits movetime;
+  movetime.movetime = std::chrono::milliseconds(50);
+  const auto start = std::chrono::steady_clock::now();
+  const Search::Result by_time = Search::search(board, movetime);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  EXPECT_TRUE(legal.contains(by_time.best_move));
+}
+
+/**
+ * @test SearchTest.EvaluationSymmetry
+ * @brief Verifies that the evaluation is relative to the side to move and symmetric between colors.
+ */
+TEST(SearchTest, EvaluationSymmetry) {
+  EXPECT_EQ(Search::evaluate(Board()), 0);
+
+  const Board white("4k3/8/8/8/3N4/8/8/4K3 w - - 0 1");
+  const Board black("4k3/8/8/3n4/8/8/8/4K3 b - - 0 1");
+  EXPECT_GT(Search::evaluate(white), 300);
+  EXPECT_EQ(Search::evaluate(white), Search::evaluate(black));
+}
+
+/**
+ * @test SearchTest.TranspositionTable
+ * @brief Verifies that a table keeps results and mate distances right, and saves nodes on a repeated search.
+ */
+TEST(SearchTest, TranspositionTable) {
+  TranspositionTable table(4);
+  const Board mate("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+  const Search::Result mate_result = Search::search(mate, depth_limit(4), {}, {}, &table);
+  EXPECT_EQ(mate_result.best_move.to_uci(), "a1a8");
+  EXPECT_EQ(mate_result.score, Search::VALUE_MATE - 1);
+
+  const Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+  const Search::Result without = Search::search(board, depth_limit(4));
+  table.clear();
+  const Search::Result first = Search::search(board, depth_limit(4), {}, {}, &table);
+  const Search::Result second = Search::search(board, depth_limit(4), {}, {}, &table);
+  EXPECT_LT(first.nodes, without.nodes);
+  EXPECT_LT(second.nodes, first.nodes);
+  EXPECT_TRUE(is_legal_line(board, second.pv));
+}
+
+/**
+ * @test SearchTest.LazySmp
+ * @brief Verifies that several threads sharing a table return a legal line of the requested depth, honor the
+ * node limit over all threads, and still find a forced mate.
+ */
+TEST(SearchTest, LazySmp) {
+  TranspositionTable table(4);
+  const Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+  std::vector<Search::Info> reports;
+  const auto on_info = [&reports](const Search::Info& info) { reports.push_back(info); };
+  const Search::Result result = Search::search(board, depth_limit(5), on_info, {}, &table, 4);
+  EXPECT_EQ(result.depth, 5);
+  EXPECT_EQ(result.best_move, result.pv.front());
+  EXPECT_TRUE(is_legal_line(board, result.pv));
+  ASSERT_FALSE(reports.empty());
+  EXPECT_EQ(reports.back().depth, 5);
+  EXPECT_EQ(reports.back().pv, result.pv);
+  EXPECT_LE(reports.back().nodes, result.nodes);
+
+  Search::Limits nodes;
+  nodes.nodes = 50000;
+  table.clear();
+  const Search::Result limited = Search::search(board, nodes, {}, {}, &table, 4);
+  // Each thread may overshoot by the interval at which it polls the other counters
+  EXPECT_LE(limited.nodes, nodes.nodes + 4 * 1024);
+  EXPECT_TRUE(is_legal_line(board, limited.pv));
+
+  const Board mate("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+  const Search::Result mate_result = Search::search(mate, depth_limit(4), {}, {}, &table, 3);
+  EXPECT_EQ(mate_result.best_move.to_uci(), "a1a8");
+  EXPECT_EQ(mate_result.score, Search::VALUE_MATE - 1);
+}
+
+/**
+ * @test SearchTest.OrderingStats
+ * @brief Verifies that cutoff statistics are consistent, that most cutoffs come from the first move, and that the
+ * main thread's report matches the result of a single-threaded search.
+ */
+TEST(SearchTest, OrderingStats) {
+  const Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+  std::vector<Search::Info> reports;
+  const auto on_info = [&reports](const Search::Info& info) { reports.push_back(info); };
+  const Search::Result result = Search::search(board, depth_limit(4), on_info);
+  const Search::Stats& stats = result.stats;
+  EXPECT_GT(stats.cutoffs, 0u);
+  EXPECT_LE(stats.first_move_cutoffs, stats.cutoffs);
+  EXPECT_GE(stats.cutoff_index_sum, stats.cutoffs - stats.first_move_cutoffs);
+  EXPECT_GT(stats.first_move_cutoff_rate(), 0.8);
+  EXPECT_LT(stats.average_cutoff_index(), 1.0);
+
+  ASSERT_FALSE(reports.empty());
+  EXPECT_EQ(reports.back().stats.cutoffs, stats.cutoffs);
+  EXPECT_LE(reports.front().stats.cutoffs, stats.cutoffs);
+
+  const Search::Stats none;
+  EXPECT_EQ(none.first_move_cutoff_rate(), 0.0);
+  EXPECT_EQ(none.average_cutoff_index(), 0.0);
+}
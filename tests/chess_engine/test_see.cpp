@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <chess_engine/board.hpp>
+#include <chess_engine/move.hpp>
+#include <chess_engine/movegen.hpp>
+#include <chess_engine/see.hpp>
+#include <chess_engine/square.hpp>
+
+using See::PIECE_VALUES;
+
+namespace {
+
+constexpr int PAWN = PIECE_VALUES[Piece::P];
+constexpr int KNIGHT = PIECE_VALUES[Piece::N];
+constexpr int BISHOP = PIECE_VALUES[Piece::B];
+constexpr int ROOK = PIECE_VALUES[Piece::R];
+constexpr int QUEEN = PIECE_VALUES[Piece::Q];
+
+Move move(Square::Value from, Square::Value to, Move::Type type = Move::NORMAL) {
+  return Move(Square(from), Square(to), type);
+}
+
+}  // namespace
+
+/**
+ * @test SeeTest.UndefendedCapture
+ * @brief Verifies that taking an undefended piece wins the whole piece.
+ */
+TEST(SeeTest, UndefendedCapture) {
+  const Board board("1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1");
+  EXPECT_EQ(See::see(board, move(Square::E1, Square::E5)), PAWN);
+}
+
+/**
+ * @test SeeTest.LosingCaptureWithXrays
+ * @brief Verifies a knight taking a pawn defended by a knight, with rook, queen and bishop x-rays on both sides.
+ *
+ * Nxe5 Nxe5 Rxe5 Bxe5 Qxe5 Qxe5 (the black queen is uncovered behind the bishop): white should stop after
+ * the first recapture and loses a knight for a pawn.
+ */
+TEST(SeeTest, LosingCaptureWithXrays) {
+  const Board board("1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1");
+  EXPECT_EQ(See::see(board, move(Square::D3, Square::E5)), PAWN - KNIGHT);
+}
+
+/**
+ * @test SeeTest.DoubledRooksXray
+ * @brief Verifies that a rook behind another rook joins the exchange once the front rook has captured.
+ */
+TEST(SeeTest, DoubledRooksXray) {
+  // Rxd4 Rxd4 Rxd4 Rxd4: black has the last word thanks to its second rook
+  const Board board("3r3k/3r4/8/8/3p4/8/3R4/3R3K w - - 0 1");
+  EXPECT_EQ(See::see(board, move(Square::D2, Square::D4)), PAWN - ROOK);
+
+  // Without the second black rook, white wins the pawn
+  const Board single("7k/3r4/8/8/3p4/8/3R4/3R3K w - - 0 1");
+  EXPECT_EQ(See::see(single, move(Square::D2, Square::D4)), PAWN);
+}
+
+/**
+ * @test SeeTest.BishopBehindPawn
+ * @brief Verifies that a bishop uncovered behind a capturing pawn defends the square.
+ */
+TEST(SeeTest, BishopBehindPawn) {
+  // exd5 Bxd5 Bxd5: the white bishop on f3 recaptures through e4
+  const Board board("4k3/8/2b5/3n4/4P3/5B2/8/4K3 w - - 0 1");
+  EXPECT_EQ(See::see(board, move(Square::E4, Square::D5)), KNIGHT);
+
+  // The knight blocks the bishop: d4 is not defended and a quiet queen move there risks nothing
+  const Board queen("4k3/8/2b5/3n4/8/8/8/Q3K3 w - - 0 1");
+  EXPECT_EQ(See::see(queen, move(Square::A1, Square::D4)), 0);
+}
+
+/**
+ * @test SeeTest.SpecialMoves
+ * @brief Verifies en passant, promotions, quiet moves and castling.
+ */
+TEST(SeeTest, SpecialMoves) {
+  const Board en_passant("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1");
+  EXPECT_EQ(See::see(en_passant, move(Square::E5, Square::D6, Move::EN_PASSANT)), PAWN);
+
+  const Board promotion("1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1");
+  const Move axb8q = Move::make_promotion(Square(Square::A7), Square(Square::B8), Piece::Q);
+  EXPECT_EQ(See::see(promotion, axb8q), ROOK + QUEEN - PAWN);
+
+  // The black king recaptures the new queen
+  const Board defended("1rk5/P7/8/8/8/8/8/4K3 w - - 0 1");
+  EXPECT_EQ(See::see(defended, axb8q), ROOK - PAWN);
+
+  // A knight moving to a square attacked by a pawn
+  const Board quiet("4k3/8/8/8/3p4/8/8/1N2K3 w - - 0 1");
+  EXPECT_EQ(See::see(quiet, move(Square::B1, Square::C3)), -KNIGHT);
+
+  const Board castling("4k3/8/8/8/8/8/8/4K2R w K - 0 1");
+  EXPECT_EQ(See::see(castling, move(Square::E1, Square::G1, Move::CASTLING)), 0);
+}
+
+/**
+ * @test SeeTest.KingCaptures
+ * @brief Verifies that a king may take an undefended piece but never a defended one.
+ */
+TEST(SeeTest, KingCaptures) {
+  const Board undefended("4k3/8/8/8/8/8/3r4/4K3 w - - 0 1");
+  EXPECT_EQ(See::see(undefended, move(Square::E1, Square::D2)), ROOK);
+  EXPECT_TRUE(See::see_ge(undefended, move(Square::E1, Square::D2), ROOK));
+
+  const Board defended("4k3/8/8/8/8/4p3/3r4/4K3 w - - 0 1");
+  EXPECT_LT(See::see(defended, move(Square::E1, Square::D2)), 0);
+  EXPECT_FALSE(See::see_ge(defended, move(Square::E1, Square::D2), 0));
+
+  // Qxd2 Bxd2 Kxd2: the king recaptures once the square is no longer defended
+  const Board recapture("4k3/8/8/8/8/2b5/3r4/3QK3 w - - 0 1");
+  EXPECT_EQ(See::see(recapture, move(Square::D1, Square::D2)), ROOK - QUEEN + BISHOP);
+
+  // With a black rook behind on d8, Kxd2 is illegal and the queen is lost for the rook
+  const Board still_defended("3rk3/8/8/8/8/2b5/3r4/3QK3 w - - 0 1");
+  EXPECT_EQ(See::see(still_defended, move(Square::D1, Square::D2)), ROOK - QUEEN);
+}
+
+/**
+ * @test SeeTest.CrowdedExchange
+ * @brief Verifies an exchange longer than 32 captures, in a position with 37 pieces that no game can reach.
+ *
+ * More than 32 pieces, queens and bishops mostly, attack d4, so the swap list outgrows the 32 captures a real game
+ * allows.
+ */
+TEST(SeeTest, CrowdedExchange) {
+  // Placement k2q3b/b2Q2b1/1bNQNb2/1NbQbN2/qQQ1QQqq/1NbQbN2/1bNQNb1K/b2q2b1, set square by square
+  const char* ranks[] = {"b2q2b1", "1bNQNb1K", "1NbQbN2", "qQQ1QQqq", "1NbQbN2", "1bNQNb2", "b2Q2b1", "k2q3b"};
+  Board board("4k3/8/8/8/8/8/8/4K3 w - - 0 1");
+  board.remove_piece(Square(Square::E1));
+  board.remove_piece(Square(Square::E8));
+  for (int rank = 0; rank < 8; ++rank) {
+    int file = 0;
+    for (const char* c = ranks[rank]; *c; ++c) {
+      if (*c >= '1' && *c <= '8') {
+        file += *c - '0';
+      } else {
+        board.set_piece(Square::unchecked(file++, rank), Piece(*c));
+      }
+    }
+  }
+  ASSERT_EQ(board.occupied().popcount(), 37);
+
+  const Move capture = move(Square::D3, Square::D4);
+  const int value = See::see(board, capture);
+  EXPECT_GE(value, -QUEEN);
+  EXPECT_LE(value, QUEEN);
+  EXPECT_TRUE(See::see_ge(board, capture, value));
+  EXPECT_FALSE(See::see_ge(board, capture, value + 1));
+}
+
+/**
+ * @test SeeTest.ThresholdMatchesSee
+ * @brief Verifies see_ge(move, t) == (see(move) >= t) for every legal move of tactical positions and a range of t.
+ */
+TEST(SeeTest, ThresholdMatchesSee) {
+  const char* fens[] = {
+      "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+      "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+      "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+      "1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1",
+      "3r3k/3r4/8/8/3p4/8/3R4/3R3K w - - 0 1",
+      "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+      "2r1r1k1/pp1bqpp1/2np1n1p/2p1p3/2P1P1P1/2NPBN1P/PP2QP2/R4RK1 b - - 0 1",
+  };
+  for (const char* fen : fens) {
+    const Board board(fen);
+    MoveList moves;
+    MoveGen::generate_legal(board, moves);
+    for (const Move m : moves) {
+      const int value = See::see(board, m);
+      for (int threshold = -1000; threshold <= 1500; threshold += 10) {
+        ASSERT_EQ(See::see_ge(board, m, threshold), value >= threshold)
+            << fen << " " << m.to_uci() << " see=" << value << " threshold=" << threshold;
+      }
+    }
+  }
+}
@@ -158,4 +158,18 @@ TEST(SquareTest, EnumValueMapping) {
   EXPECT_EQ(s1.rank(), 0);
   EXPECT_EQ(s2.file(), 7);
   EXPECT_EQ(s2.rank(), 7);
-}
\ No newline at end of file
+}
+
+/**
+ * @test Unchecked factories.
+ * @brief Confirms Square::unchecked matches the checked constructors on every square, at compile time too.
+ */
+TEST(SquareTest, UncheckedFactories) {
+  static_assert(Square::unchecked(28) == Square(Square::E4));
+  static_assert(Square::unchecked(4, 3) == Square(Square::E4));
+
+  for (int i = 0; i < 64; ++i) {
+    EXPECT_EQ(Square::unchecked(i), Square(i));
+    EXPECT_EQ(Square::unchecked(i % 8, i / 8), Square(i % 8, i / 8));
+  }
+}
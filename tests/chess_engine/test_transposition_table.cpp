@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chess_engine/move.hpp>
+#include <chess_engine/square.hpp>
+#include <chess_engine/transposition_table.hpp>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+/** Keys sharing their top 16 bits land in the same cluster of any table of at most 2^16 clusters. */
+constexpr uint64_t SAME_CLUSTER = 0xABCD000000000000ULL;
+
+const Move E2E4(Square(Square::E2), Square(Square::E4));
+const Move G1F3(Square(Square::G1), Square(Square::F3));
+
+int stored_depth(const TranspositionTable& table, uint64_t key) {
+  TranspositionTable::Data data{};
+  return table.probe(key, data) ? data.depth : -1;
+}
+
+}  // namespace
+
+/**
+ * @test TranspositionTableTest.StoreAndProbe
+ * @brief Verifies that every field of an entry survives the packing, and that other keys miss.
+ */
+TEST(TranspositionTableTest, StoreAndProbe) {
+  TranspositionTable table(1);
+  EXPECT_EQ(table.size(), (1u << 20) / 16);
+
+  table.store(0x123456789ABCDEF0ULL, E2E4, -31990, 42, TranspositionTable::LOWER);
+  TranspositionTable::Data data{};
+  ASSERT_TRUE(table.probe(0x123456789ABCDEF0ULL, data));
+  EXPECT_EQ(data.move, E2E4);
+  EXPECT_EQ(data.score, -31990);
+  EXPECT_EQ(data.depth, 42);
+  EXPECT_EQ(data.bound, TranspositionTable::LOWER);
+
+  EXPECT_FALSE(table.probe(0x123456789ABCDEF1ULL, data));
+  EXPECT_FALSE(table.probe(0, data));
+
+  table.clear();
+  EXPECT_FALSE(table.probe(0x123456789ABCDEF0ULL, data));
+}
+
+/**
+ * @test TranspositionTableTest.SameKeyReplacement
+ * @brief Verifies that a shallow bound does not overwrite a deep result of the same search, and that a null
+ * move keeps the stored one.
+ */
+TEST(TranspositionTableTest, SameKeyReplacement) {
+  TranspositionTable table(1);
+  const uint64_t key = 0x0F0F0F0F0F0F0F0FULL;
+
+  table.store(key, E2E4, 10, 12, TranspositionTable::EXACT);
+  table.store(key, G1F3, 50, 2, TranspositionTable::UPPER);
+  EXPECT_EQ(stored_depth(table, key), 12);
+
+  table.store(key, Move(), 20, 9, TranspositionTable::UPPER);
+  TranspositionTable::Data data{};
+  ASSERT_TRUE(table.probe(key, data));
+  EXPECT_EQ(data.depth, 9);
+  EXPECT_EQ(data.move, E2E4);
+
+  // In a later search the old result no longer protects itself
+  table.new_search();
+  table.store(key, G1F3, 0, 1, TranspositionTable::LOWER);
+  ASSERT_TRUE(table.probe(key, data));
+  EXPECT_EQ(data.depth, 1);
+  EXPECT_EQ(data.move, G1F3);
+}
+
+/**
+ * @test TranspositionTableTest.ClusterReplacement
+ * @brief Verifies that a full cluster evicts its shallowest entry, old entries losing worth with each search.
+ */
+TEST(TranspositionTableTest, ClusterReplacement) {
+  TranspositionTable table(1);
+  const int depths[] = {10, 2, 8, 6};
+  for (int i = 0; i < 4; ++i) table.store(SAME_CLUSTER + i, E2E4, 0, depths[i], TranspositionTable::EXACT);
+  for (int i = 0; i < 4; ++i) EXPECT_EQ(stored_depth(table, SAME_CLUSTER + i), depths[i]);
+
+  table.store(SAME_CLUSTER + 4, E2E4, 0, 5, TranspositionTable::EXACT);
+  EXPECT_EQ(stored_depth(table, SAME_CLUSTER + 1), -1);
+  EXPECT_EQ(stored_depth(table, SAME_CLUSTER + 4), 5);
+
+  // One search later, a fresh depth 1 entry is worth more than an old depth 8 one
+  table.new_search();
+  table.store(SAME_CLUSTER + 5, E2E4, 0, 1, TranspositionTable::EXACT);
+  EXPECT_EQ(stored_depth(table, SAME_CLUSTER + 4), -1);
+  table.store(SAME_CLUSTER + 6, E2E4, 0, 1, TranspositionTable::EXACT);
+  EXPECT_EQ(stored_depth(table, SAME_CLUSTER + 5), 1);
+  EXPECT_EQ(stored_depth(table, SAME_CLUSTER + 3), -1);
+  EXPECT_EQ(stored_depth(table, SAME_CLUSTER + 0), 10);
+}
+
+/**
+ * @test TranspositionTableTest.ConcurrentWritesAreValidated
+ * @brief Verifies that threads hammering the same clusters never read an entry mixing two positions.
+ *
+ * Each key is stored with a score and depth derived from it, so any hit returning other values comes from a
+ * torn entry that passed validation.
+ */
+TEST(TranspositionTableTest, ConcurrentWritesAreValidated) {
+  TranspositionTable table(1);
+  std::atomic<int> mismatches{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&table, &mismatches, t] {
+      for (uint64_t i = 0; i < 200000; ++i) {
+        const uint64_t key = SAME_CLUSTER + ((i * 7 + t) % 64);
+        table.store(key, E2E4, static_cast<int>(key % 1000), static_cast<int>(key % 200), TranspositionTable::EXACT);
+        TranspositionTable::Data data{};
+        const uint64_t other = SAME_CLUSTER + ((i * 13 + t) % 64);
+        if (table.probe(other, data) && (data.score != static_cast<int>(other % 1000) ||
+                                         data.depth != static_cast<int>(other % 200) || data.move != E2E4)) {
+          ++mismatches;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_EQ(mismatches.load(), 0);
+}
+
+/**
+ * @test TranspositionTableTest.ResizeAndHashfull
+ * @brief Verifies resizing, and that hashfull only counts entries of the current search.
+ */
+TEST(TranspositionTableTest, ResizeAndHashfull) {
+  TranspositionTable table(1);
+  ASSERT_TRUE(table.resize(4));
+  EXPECT_EQ(table.size(), 4 * (1u << 20) / 16);
+  EXPECT_EQ(table.hashfull(), 0);
+
+  // Keys spread evenly over the whole table
+  const uint64_t step = UINT64_MAX / table.size();
+  for (uint64_t i = 0; i < table.size(); ++i) table.store(i * step + 1, E2E4, 0, 1, TranspositionTable::EXACT);
+  EXPECT_GT(table.hashfull(), 900);
+
+  table.new_search();
+  EXPECT_EQ(table.hashfull(), 0);
+}
+
+/**
+ * @test TranspositionTableTest.SharedMemory
+ * @brief Verifies that two tables attached to the same segment see each other's entries, that the segment keeps
+ * the size of its creator, and that resizing goes back to a private table.
+ */
+TEST(TranspositionTableTest, SharedMemory) {
+  const std::string name = "/chess_engine_test_tt_" + std::to_string(getpid());
+  TranspositionTable::remove_shared(name);
+
+  TranspositionTable creator(1);
+  TranspositionTable other(1);
+  const auto created = creator.attach_shared(name, 2);
+  ASSERT_TRUE(created) << created.error().message();
+  const auto attached = other.attach_shared(name, 8);
+  ASSERT_TRUE(attached) << attached.error().message();
+  EXPECT_EQ(creator.shared_name(), name);
+  EXPECT_EQ(creator.size(), 2 * (1u << 20) / 16);
+  EXPECT_EQ(other.size(), creator.size());
+
+  creator.store(0x123456789ABCDEF0ULL, E2E4, 25, 7, TranspositionTable::EXACT);
+  TranspositionTable::Data data{};
+  ASSERT_TRUE(other.probe(0x123456789ABCDEF0ULL, data));
+  EXPECT_EQ(data.move, E2E4);
+  EXPECT_EQ(data.score, 25);
+  EXPECT_EQ(data.depth, 7);
+
+  // Once the name is removed, a new segment starts empty while the attached tables keep theirs
+  EXPECT_TRUE(TranspositionTable::remove_shared(name));
+  TranspositionTable fresh(1);
+  ASSERT_TRUE(fresh.attach_shared(name, 1));
+  EXPECT_FALSE(fresh.probe(0x123456789ABCDEF0ULL, data));
+  EXPECT_TRUE(other.probe(0x123456789ABCDEF0ULL, data));
+  EXPECT_TRUE(TranspositionTable::remove_shared(name));
+
+  ASSERT_TRUE(other.resize(1));
+  EXPECT_TRUE(other.shared_name().empty());
+  EXPECT_FALSE(other.probe(0x123456789ABCDEF0ULL, data));
+  EXPECT_TRUE(creator.probe(0x123456789ABCDEF0ULL, data));
+
+  EXPECT_FALSE(TranspositionTable::remove_shared(name));
+}
+
+/**
+ * @test TranspositionTableTest.SharedGeneration
+ * @brief Verifies that tables attached to the same segment age entries against one generation: entries fresh
+ * for one process are fresh for the others, whatever number of searches each of them has started.
+ */
+TEST(TranspositionTableTest, SharedGeneration) {
+  const std::string name = "/chess_engine_test_tt_generation_" + std::to_string(getpid());
+  TranspositionTable::remove_shared(name);
+
+  TranspositionTable first(1);
+  TranspositionTable second(1);
+  ASSERT_TRUE(first.attach_shared(name, 1));
+  ASSERT_TRUE(second.attach_shared(name, 1));
+  EXPECT_TRUE(TranspositionTable::remove_shared(name));
+
+  // Keys of the first cluster, which hashfull() samples
+  constexpr uint64_t FIRST_CLUSTER = 0;
+
+  // Only the first process has run searches so far
+  for (int i = 0; i < 3; ++i) first.new_search();
+
+  // Two deep entries from the first process, then the second one fills the rest of the cluster with shallow
+  // entries and has to replace one of them
+  first.store(FIRST_CLUSTER + 1, E2E4, 0, 20, TranspositionTable::EXACT);
+  first.store(FIRST_CLUSTER + 2, E2E4, 0, 20, TranspositionTable::EXACT);
+  second.store(FIRST_CLUSTER + 3, G1F3, 0, 2, TranspositionTable::EXACT);
+  second.store(FIRST_CLUSTER + 4, G1F3, 0, 2, TranspositionTable::EXACT);
+  second.store(FIRST_CLUSTER + 5, G1F3, 0, 3, TranspositionTable::EXACT);
+
+  EXPECT_EQ(stored_depth(second, FIRST_CLUSTER + 1), 20);
+  EXPECT_EQ(stored_depth(second, FIRST_CLUSTER + 2), 20);
+  EXPECT_EQ(stored_depth(first, FIRST_CLUSTER + 5), 3);
+  EXPECT_GT(second.hashfull(), 0);
+  EXPECT_EQ(first.hashfull(), second.hashfull());
+
+  // The same holds the other way around once the second process starts a search of its own
+  second.new_search();
+  second.store(FIRST_CLUSTER + 6, G1F3, 0, 20, TranspositionTable::EXACT);
+  first.store(FIRST_CLUSTER + 7, E2E4, 0, 1, TranspositionTable::EXACT);
+  EXPECT_EQ(stored_depth(first, FIRST_CLUSTER + 6), 20);
+  EXPECT_EQ(stored_depth(second, FIRST_CLUSTER + 7), 1);
+}
+
+/**
+ * @test TranspositionTableTest.SharedSetupPending
+ * @brief Verifies that attaching to a segment whose creator never finished setting it up fails instead of using
+ * unconstructed entries.
+ */
+TEST(TranspositionTableTest, SharedSetupPending) {
+  const std::string name = "/chess_engine_test_tt_pending_" + std::to_string(getpid());
+  TranspositionTable::remove_shared(name);
+
+  // A creator that sized the segment but died before publishing it
+  const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(ftruncate(fd, 1 << 20), 0);
+  close(fd);
+
+  TranspositionTable table(1);
+  const auto attached = table.attach_shared(name, 1);
+  ASSERT_FALSE(attached);
+  EXPECT_EQ(attached.error(), std::errc::resource_unavailable_try_again);
+  EXPECT_TRUE(table.shared_name().empty());
+  EXPECT_TRUE(TranspositionTable::remove_shared(name));
+}
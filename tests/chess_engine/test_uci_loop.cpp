@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <sstream>
+#include <unistd.h>
+
+#define UCI_LOOP_NO_MAIN
 #include "../main/uci_loop.cpp"
 
 /**
@@ -44,6 +47,8 @@ TEST_F(UciLoopTest, UciCommand) {
     std::string response = output.str();
     EXPECT_TRUE(response.find("id name ChessEngine") != std::string::npos);
     EXPECT_TRUE(response.find("id author Hardcode") != std::string::npos);
+    EXPECT_TRUE(response.find("option name Hash type spin") != std::string::npos);
+    EXPECT_TRUE(response.find("option name Threads type spin") != std::string::npos);
     EXPECT_TRUE(response.find("uciok") != std::string::npos);
 }
 
@@ -67,14 +72,214 @@ TEST_F(UciLoopTest, IsReadyCommand) {
  *
  * Verifies that the engine can process a move calculation request.
  * This is one of the most important commands as it triggers the engine's
- * main functionality of finding the best move.
+ * main functionality of finding the best move. Without limits, the search
+ * runs until stopped, here by the end of the input, and still ends with a
+ * legal best move.
  */
 TEST_F(UciLoopTest, GoCommand) {
     input << "go\n";
     uci_loop(input, output);
 
     std::string response = output.str();
-    EXPECT_EQ(response, "bestmove e2e4\n");
+    EXPECT_TRUE(response.find("info depth 1 score cp ") != std::string::npos);
+    const std::size_t bestmove = response.find("bestmove ");
+    ASSERT_NE(bestmove, std::string::npos);
+
+    const std::string uci = response.substr(bestmove + 9, response.find('\n', bestmove) - bestmove - 9);
+    EXPECT_FALSE(parse_move(Board(), uci).is_null());
+}
+
+/**
+ * @brief Tests the go depth command
+ *
+ * Verifies one info line per iteration, with depth, score, node count, speed,
+ * time and principal variation, that the search stops at the requested depth,
+ * and that the move ordering statistics are reported before the best move.
+ */
+TEST_F(UciLoopTest, GoDepthCommand) {
+    input << "go depth 3\n";
+    uci_loop(input, output);
+
+    std::string response = output.str();
+    EXPECT_TRUE(response.find("info depth 3 score cp ") != std::string::npos);
+    EXPECT_TRUE(response.find("info depth 4") == std::string::npos);
+    EXPECT_TRUE(response.find(" nodes ") != std::string::npos);
+    EXPECT_TRUE(response.find(" nps ") != std::string::npos);
+    EXPECT_TRUE(response.find(" time ") != std::string::npos);
+    EXPECT_TRUE(response.find(" pv ") != std::string::npos);
+    const std::size_t stats = response.find("info string cutoffs ");
+    ASSERT_NE(stats, std::string::npos);
+    EXPECT_NE(response.find("% avgindex ", stats), std::string::npos);
+    EXPECT_NE(response.find("bestmove ", stats), std::string::npos);
+}
+
+/**
+ * @brief Tests the go nodes and go movetime commands
+ *
+ * Verifies that both budgets end the search with a best move.
+ */
+TEST_F(UciLoopTest, GoNodesAndMovetimeCommands) {
+    input << "go nodes 5000\ngo movetime 20\n";
+    uci_loop(input, output);
+
+    std::string response = output.str();
+    const std::size_t first = response.find("bestmove ");
+    ASSERT_NE(first, std::string::npos);
+    EXPECT_NE(response.find("bestmove ", first + 1), std::string::npos);
+}
+
+/**
+ * @brief Tests the go infinite and stop commands
+ *
+ * Verifies that the search runs in the background: the engine answers
+ * isready while searching, and an infinite search only reports its best
+ * move once stopped, after at least one completed iteration.
+ */
+TEST_F(UciLoopTest, GoInfiniteAndStopCommands) {
+    input << "go infinite\nisready\nstop\nisready\n";
+    uci_loop(input, output);
+
+    std::string response = output.str();
+    const std::size_t ready = response.find("readyok\n");
+    const std::size_t bestmove = response.find("bestmove ");
+    ASSERT_NE(ready, std::string::npos);
+    ASSERT_NE(bestmove, std::string::npos);
+    EXPECT_LT(ready, bestmove);
+    EXPECT_LT(response.find("info depth 1 "), bestmove);
+    EXPECT_NE(response.find("readyok\n", bestmove), std::string::npos);
+    EXPECT_EQ(response.find("bestmove ", bestmove + 1), std::string::npos);
+}
+
+/**
+ * @brief Tests that quit interrupts a search
+ *
+ * Verifies that a search without limits, which would otherwise run for
+ * ever, is stopped by quit and reports its best move.
+ */
+TEST_F(UciLoopTest, QuitInterruptsSearch) {
+    input << "go\nquit\ngo depth 1\n";
+    uci_loop(input, output);
+
+    std::string response = output.str();
+    const std::size_t bestmove = response.find("bestmove ");
+    ASSERT_NE(bestmove, std::string::npos);
+    EXPECT_EQ(response.find("bestmove ", bestmove + 1), std::string::npos);
+}
+
+/**
+ * @brief Tests the position command
+ *
+ * Verifies that the searched position is the one set up with startpos or fen,
+ * followed by moves: the engine finds the mate of the fool's mate line and
+ * the back-rank mate of a FEN position.
+ */
+TEST_F(UciLoopTest, PositionCommand) {
+    input << "position startpos moves f2f3 e7e5 g2g4\ngo depth 2\n";
+    input << "position fen 6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1\ngo depth 2\n";
+    uci_loop(input, output);
+
+    std::string response = output.str();
+    EXPECT_TRUE(response.find("score mate 1 ") != std::string::npos);
+    EXPECT_TRUE(response.find("bestmove d8h4\n") != std::string::npos);
+    EXPECT_TRUE(response.find("bestmove a1a8\n") != std::string::npos);
+}
+
+/**
+ * @brief Tests the position command with moves leading to a mate
+ *
+ * Verifies that the engine answers "bestmove 0000" when the side to move has no
+ * legal move, and that an illegal move ends the move list.
+ */
+TEST_F(UciLoopTest, PositionWithoutLegalMove) {
+    input << "position startpos moves f2f3 e7e5 g2g4 d8h4\ngo depth 2\n";
+    input << "position startpos moves e2e4 e2e4 e7e5\ngo perft 1\n";
+    uci_loop(input, output);
+
+    std::string response = output.str();
+    EXPECT_TRUE(response.find("info depth") == std::string::npos);
+    EXPECT_TRUE(response.find("bestmove 0000\n") != std::string::npos);
+    // Only e2e4 was played: black has 20 replies
+    EXPECT_TRUE(response.find("Nodes searched: 20\n") != std::string::npos);
+}
+
+/**
+ * @brief Tests the go perft command
+ *
+ * Verifies that the engine prints one line per root move with its node count,
+ * followed by the total number of nodes.
+ */
+TEST_F(UciLoopTest, GoPerftCommand) {
+    input << "go perft 2\n";
+    uci_loop(input, output);
+
+    std::string response = output.str();
+    EXPECT_TRUE(response.find("e2e4: 20\n") != std::string::npos);
+    EXPECT_TRUE(response.find("g1f3: 20\n") != std::string::npos);
+    EXPECT_TRUE(response.find("Nodes searched: 400\n") != std::string::npos);
+    EXPECT_TRUE(response.find("bestmove") == std::string::npos);
+}
+
+/**
+ * @brief Tests the setoption and ucinewgame commands
+ *
+ * Verifies that the hash table can be resized and cleared between searches
+ * without disturbing them, and that the info lines report its usage.
+ */
+TEST_F(UciLoopTest, HashOption) {
+    input << "setoption name Hash value 1\ngo depth 3\nucinewgame\nsetoption name Hash value 2\ngo depth 3\n";
+    uci_loop(input, output);
+
+    std::string response = output.str();
+    EXPECT_TRUE(response.find(" hashfull ") != std::string::npos);
+    const std::size_t first = response.find("bestmove ");
+    ASSERT_NE(first, std::string::npos);
+    EXPECT_NE(response.find("bestmove ", first + 1), std::string::npos);
+}
+
+/**
+ * @brief Tests the Threads option
+ *
+ * Verifies that a multithreaded search reports its iterations and a best move.
+ */
+TEST_F(UciLoopTest, ThreadsOption) {
+    input << "setoption name Threads value 4\ngo depth 4\n";
+    uci_loop(input, output);
+
+    std::string response = output.str();
+    EXPECT_TRUE(response.find("info depth 4 ") != std::string::npos);
+    EXPECT_TRUE(response.find("bestmove ") != std::string::npos);
+}
+
+/**
+ * @brief Tests the SharedHash option
+ *
+ * Verifies that two engines given the same segment name share one table: the
+ * second one searching the same position needs fewer nodes than the first.
+ */
+TEST_F(UciLoopTest, SharedHashOption) {
+    const std::string name = "/chess_engine_test_uci_" + std::to_string(getpid());
+    TranspositionTable::remove_shared(name);
+    const std::string commands = "setoption name SharedHash value " + name + "\ngo depth 5\n";
+
+    std::stringstream first_input(commands);
+    std::stringstream first_output;
+    uci_loop(first_input, first_output);
+    std::stringstream second_input(commands + "setoption name SharedHash value <empty>\n");
+    std::stringstream second_output;
+    uci_loop(second_input, second_output);
+    TranspositionTable::remove_shared(name);
+
+    const auto nodes_at_depth_5 = [](const std::string &response) {
+        const std::size_t info = response.find("info depth 5 ");
+        EXPECT_NE(info, std::string::npos);
+        return std::stoull(response.substr(response.find(" nodes ", info) + 7));
+    };
+    EXPECT_TRUE(first_output.str().find("info string SharedHash") == std::string::npos);
+    EXPECT_LT(nodes_at_depth_5(second_output.str()), nodes_at_depth_5(first_output.str()));
+
+    input << "setoption name SharedHash value no_slash/invalid\n";
+    uci_loop(input, output);
+    EXPECT_TRUE(output.str().find("info string SharedHash") != std::string::npos);
 }
 
 /**
@@ -106,7 +311,7 @@ TEST_F(UciLoopTest, MultipleCommands) {
     std::string response = output.str();
     EXPECT_TRUE(response.find("id name ChessEngine") != std::string::npos);
     EXPECT_TRUE(response.find("readyok") != std::string::npos);
-    EXPECT_TRUE(response.find("bestmove e2e4") != std::string::npos);
+    EXPECT_TRUE(response.find("bestmove ") != std::string::npos);
 }
 
 /**
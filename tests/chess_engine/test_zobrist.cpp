@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <chess_engine/board.hpp>
+#include <chess_engine/move.hpp>
+#include <chess_engine/piece.hpp>
+#include <chess_engine/square.hpp>
+#include <chess_engine/zobrist.hpp>
+#include <cstdint>
+#include <optional>
+
+namespace {
+
+const std::string KIWIPETE = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+}  // namespace
+
+/**
+ * @test ZobristTest.KeysAreDistinct
+ * @brief Verifies that no two piece-square keys collide (a collision would make two positions share a key).
+ */
+TEST(ZobristTest, KeysAreDistinct) {
+  for (int a = 0; a < 12 * 64; ++a) {
+    for (int b = a + 1; b < 12 * 64; ++b) {
+      ASSERT_NE(Zobrist::PIECE_SQUARE[a / 64][a % 64], Zobrist::PIECE_SQUARE[b / 64][b % 64]);
+    }
+  }
+}
+
+/**
+ * @test ZobristTest.FenConstructorComputesKey
+ * @brief Verifies that the key built by the FEN constructor matches a full recomputation.
+ */
+TEST(ZobristTest, FenConstructorComputesKey) {
+  Board start;
+  EXPECT_EQ(start.hash(), start.compute_hash());
+  EXPECT_NE(start.hash(), 0ULL);
+
+  Board kiwipete(KIWIPETE);
+  EXPECT_EQ(kiwipete.hash(), kiwipete.compute_hash());
+  EXPECT_NE(kiwipete.hash(), start.hash());
+}
+
+/**
+ * @test ZobristTest.StateFieldsChangeKey
+ * @brief Verifies that side to move, castling rights and en passant file all contribute to the key.
+ */
+TEST(ZobristTest, StateFieldsChangeKey) {
+  const Board white("4k3/8/8/3pP3/8/8/8/4K2R w K d6 0 1");
+  const Board black("4k3/8/8/3pP3/8/8/8/4K2R b K d6 0 1");
+  const Board no_castling("4k3/8/8/3pP3/8/8/8/4K2R w - d6 0 1");
+  const Board no_en_passant("4k3/8/8/3pP3/8/8/8/4K2R w K - 0 1");
+
+  EXPECT_NE(white.hash(), black.hash());
+  EXPECT_NE(white.hash(), no_castling.hash());
+  EXPECT_NE(white.hash(), no_en_passant.hash());
+
+  // Clocks are not part of the position
+  const Board other_clocks("4k3/8/8/3pP3/8/8/8/4K2R w K d6 12 40");
+  EXPECT_EQ(white.hash(), other_clocks.hash());
+}
+
+/**
+ * @test ZobristTest.SettersUpdateKey
+ * @brief Verifies that state setters update the key incrementally and are reversible.
+ */
+TEST(ZobristTest, SettersUpdateKey) {
+  Board board(KIWIPETE);
+  const uint64_t initial = board.hash();
+
+  board.set_white_turn(false);
+  board.set_castling_rights(Board::BLACK_KINGSIDE);
+  board.set_en_passant_square(Square(Square::C6));
+  EXPECT_EQ(board.hash(), board.compute_hash());
+  EXPECT_NE(board.hash(), initial);
+
+  board.set_white_turn(true);
+  board.set_castling_rights(Board::WHITE_KINGSIDE | Board::WHITE_QUEENSIDE | Board::BLACK_KINGSIDE |
+                            Board::BLACK_QUEENSIDE);
+  board.set_en_passant_square(std::nullopt);
+  EXPECT_EQ(board.hash(), initial);
+}
+
+/**
+ * @test ZobristTest.TranspositionsShareKey
+ * @brief Verifies that the same position reached through different edit orders has the same key.
+ */
+TEST(ZobristTest, TranspositionsShareKey) {
+  Board a;
+  a.remove_piece(Square(Square::G1));
+  a.set_piece(Square(Square::F3), Piece('N'));
+  a.remove_piece(Square(Square::B8));
+  a.set_piece(Square(Square::C6), Piece('n'));
+
+  Board b;
+  b.remove_piece(Square(Square::B8));
+  b.set_piece(Square(Square::C6), Piece('n'));
+  b.remove_piece(Square(Square::G1));
+  b.set_piece(Square(Square::F3), Piece('N'));
+
+  EXPECT_EQ(a.hash(), b.hash());
+  EXPECT_EQ(a.hash(), Board("r1bqkbnr/pppppppp/2n5/8/8/5N2/PPPPPPPP/RNBQKB1R w KQkq - 0 1").hash());
+}
+
+/**
+ * @test ZobristTest.UncapturableEnPassantIgnored
+ * @brief Verifies that a FEN en passant square no pawn can capture on is dropped, as make_move() does after the
+ * double push, so both ways of reaching the position share a key.
+ */
+TEST(ZobristTest, UncapturableEnPassantIgnored) {
+  Board pushed;
+  pushed.make_move(Move(Square(Square::E2), Square(Square::E4)));
+
+  const Board parsed("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+  EXPECT_FALSE(parsed.en_passant_square().has_value());
+  EXPECT_EQ(parsed.hash(), pushed.hash());
+  EXPECT_EQ(parsed.hash(), parsed.compute_hash());
+
+  // A square on the rank of the side to move's own pawns cannot be a target either
+  EXPECT_FALSE(Board("4k3/8/8/8/3pP3/8/8/4K3 w - e3 0 1").en_passant_square().has_value());
+
+  // With a capturer, the square is kept and hashed
+  const Board capturable("4k3/8/8/8/3pP3/8/8/4K3 b - e3 0 1");
+  EXPECT_EQ(capturable.en_passant_square(), Square(Square::E3));
+  EXPECT_NE(capturable.hash(), Board("4k3/8/8/8/3pP3/8/8/4K3 b - - 0 1").hash());
+}
+
+/**
+ * @test ZobristTest.RandomEditSequences
+ * @brief Verifies that the incremental key matches a full recomputation after every step of random edits.
+ */
+TEST(ZobristTest, RandomEditSequences) {
+  Board board(KIWIPETE);
+  uint64_t state = 0x1234567887654321ULL;
+
+  for (int step = 0; step < 20000; ++step) {
+    const uint64_t r = Zobrist::splitmix64(state);
+    const Square sq(static_cast<int>(r % 64));
+    switch ((r >> 8) % 6) {
+      case 0:
+      case 1:
+        board.set_piece(sq, Piece(static_cast<Piece::Type>((r >> 16) % 13)));
+        break;
+      case 2:
+        board.remove_piece(sq);
+        break;
+      case 3:
+        board.set_white_turn((r >> 16) & 1);
+        break;
+      case 4:
+        board.set_castling_rights(static_cast<uint8_t>((r >> 16) % 16));
+        break;
+      default:
+        board.set_en_passant_square((r >> 16) & 1 ? std::optional<Square>(sq) : std::nullopt);
+        break;
+    }
+    ASSERT_EQ(board.hash(), board.compute_hash()) << "after step " << step;
+  }
+}